@@ -0,0 +1,211 @@
+#include "async_book.h"
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+// ── Configuration ─────────────────────────────────────────────────────────────
+static constexpr int THREAD_COUNTS[]  = {1, 2, 4, 8};
+static constexpr int DEPTHS[]         = {1, 8, 64};   // async requests in flight per gateway
+static constexpr int OPS_PER_THREAD   = 100'000;
+static constexpr int CANCEL_PCT       = 30;
+
+using Book  = OrderBook<MutexPolicy, TickLadder>;
+using Async = AsyncBook<MutexPolicy, TickLadder>;
+using Clock = std::chrono::steady_clock;
+
+// ── Pre-generated command stream ──────────────────────────────────────────────
+// Write traffic only (reads don't go through the queue). Ids are disjoint
+// per thread; cancels target the thread's own earlier adds, some of which
+// will have traded away by then.
+static std::vector<BookCommand> make_stream(int thread)
+{
+    std::mt19937 rng(static_cast<uint32_t>(thread) * 7654321u + 42u);
+    std::uniform_int_distribution<uint64_t> price_dist(9900, 10100);
+    std::uniform_int_distribution<uint64_t> qty_dist(1, 100);
+    std::uniform_int_distribution<int>      side_dist(0, 1);
+    std::uniform_int_distribution<int>      op_dist(0, 99);
+
+    std::vector<BookCommand> cmds;
+    std::vector<uint64_t> live;
+    cmds.reserve(OPS_PER_THREAD);
+
+    uint64_t next_id = static_cast<uint64_t>(thread + 1) << 40;
+    for (int i = 0; i < OPS_PER_THREAD; ++i) {
+        if (op_dist(rng) < CANCEL_PCT && !live.empty()) {
+            size_t k = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+            cmds.push_back(BookCommand::Cancel(live[k]));
+            live[k] = live.back();
+            live.pop_back();
+        } else {
+            Side side = side_dist(rng) == 0 ? Side::BUY : Side::SELL;
+            Order o = Order::Limit(++next_id, 1, side, price_dist(rng), qty_dist(rng));
+            live.push_back(o.id);
+            cmds.push_back(BookCommand::Add(o));
+        }
+    }
+    return cmds;
+}
+
+// ── Result record ─────────────────────────────────────────────────────────────
+struct RunResult {
+    std::string mode;
+    int         threads;
+    int         depth;
+    uint64_t    total_ops;
+    long        throughput_ops_per_sec;
+    long        avg_latency_ns;
+    long        p99_latency_ns;
+    double      avg_batch;
+};
+
+static RunResult summarize(const std::string& mode, int threads, int depth, double elapsed_s,
+                           std::vector<std::vector<double>>& lats, double avg_batch)
+{
+    std::vector<double> all;
+    for (auto& l : lats) all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+    double sum = 0;
+    for (double v : all) sum += v;
+
+    uint64_t ops = all.size();
+    return {mode, threads, depth, ops,
+            static_cast<long>(static_cast<double>(ops) / elapsed_s),
+            static_cast<long>(sum / static_cast<double>(ops)),
+            static_cast<long>(all[static_cast<size_t>(static_cast<double>(ops) * 0.99)]),
+            avg_batch};
+}
+
+// ── Direct: every gateway thread calls the book and waits on its lock ────────
+static RunResult run_direct(const std::vector<std::vector<BookCommand>>& streams, int threads)
+{
+    Book book;
+    std::vector<std::vector<double>> lats(threads);
+    std::vector<std::thread> workers;
+
+    auto t0 = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            lats[t].reserve(OPS_PER_THREAD);
+            for (const BookCommand& c : streams[t]) {
+                auto s = Clock::now();
+                if (c.kind == BookCommand::Kind::ADD)
+                    book.add_order(c.order);
+                else
+                    book.cancel_order(c.order.id);
+                lats[t].push_back(std::chrono::duration<double, std::nano>(Clock::now() - s).count());
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    return summarize("direct", threads, 0, elapsed, lats, 1.0);
+}
+
+// ── Async: gateways keep up to `depth` requests in flight ─────────────────────
+// Latency is submit → the gateway seeing the result. Completed requests are
+// collected after every submit (oldest first; one client's requests finish
+// in order), so a result isn't left unread for long.
+static RunResult run_async(const std::vector<std::vector<BookCommand>>& streams,
+                           int threads, int depth)
+{
+    Book book;
+    AsyncConfig cfg;
+    cfg.num_clients    = threads;
+    cfg.queue_capacity = 1024;
+    Async async(book, cfg);
+
+    std::vector<std::vector<double>> lats(threads);
+    std::vector<std::thread> workers;
+
+    auto t0 = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            lats[t].reserve(OPS_PER_THREAD);
+            std::vector<AsyncOp> ops(depth);
+            std::vector<Clock::time_point> sent(depth);
+            size_t head = 0, tail = 0;   // in flight: [head, tail)
+
+            auto complete_oldest = [&] {
+                size_t k = head++ % depth;
+                ops[k].wait();
+                lats[t].push_back(std::chrono::duration<double, std::nano>(Clock::now() - sent[k]).count());
+            };
+
+            for (const BookCommand& c : streams[t]) {
+                if (tail - head == static_cast<size_t>(depth))
+                    complete_oldest();
+                size_t k = tail++ % depth;
+                sent[k] = Clock::now();
+                async.submit(t, c, &ops[k]);
+                while (head != tail && ops[head % depth].ready())
+                    complete_oldest();
+            }
+            while (head != tail)
+                complete_oldest();
+        });
+    }
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    async.stop();
+    double avg_batch = static_cast<double>(async.processed())
+                     / static_cast<double>(std::max<uint64_t>(1, async.batches()));
+    return summarize("async", threads, depth, elapsed, lats, avg_batch);
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main()
+{
+    int max_threads = *std::max_element(std::begin(THREAD_COUNTS), std::end(THREAD_COUNTS));
+    std::vector<std::vector<BookCommand>> streams;
+    for (int t = 0; t < max_threads; ++t)
+        streams.push_back(make_stream(t));
+
+    std::cout << "========================================\n"
+              << "Async submission vs direct locked calls (MutexPolicy / TickLadder)\n"
+              << "ops_per_thread=" << OPS_PER_THREAD << " cancel=" << CANCEL_PCT << "%\n"
+              << "========================================\n\n";
+
+    std::vector<RunResult> results;
+    auto print = [](const RunResult& r) {
+        std::cout << "  [" << r.mode << "] threads=" << r.threads
+                  << " depth="  << r.depth
+                  << " | tput=" << r.throughput_ops_per_sec << " ops/s"
+                  << " | avg="  << r.avg_latency_ns << " ns"
+                  << " | p99="  << r.p99_latency_ns << " ns"
+                  << " | batch=" << r.avg_batch << "\n";
+    };
+
+    for (int tc : THREAD_COUNTS) {
+        results.push_back(run_direct(streams, tc));
+        print(results.back());
+        for (int depth : DEPTHS) {
+            results.push_back(run_async(streams, tc, depth));
+            print(results.back());
+        }
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/async_results.csv");
+    csv << "mode,threads,depth,total_ops,throughput_ops_per_sec,avg_latency_ns,p99_latency_ns,avg_batch\n";
+    for (const auto& r : results) {
+        csv << r.mode                   << ","
+            << r.threads                << ","
+            << r.depth                  << ","
+            << r.total_ops              << ","
+            << r.throughput_ops_per_sec << ","
+            << r.avg_latency_ns         << ","
+            << r.p99_latency_ns         << ","
+            << r.avg_batch              << "\n";
+    }
+
+    std::cout << "\nResults saved → results/async_results.csv\n";
+    return 0;
+}
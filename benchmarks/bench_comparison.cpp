@@ -1,4 +1,6 @@
 #include "order_book.h"
+#include "journal.h"
+#include "thread_placement.h"
 #include <thread>
 #include <vector>
 #include <chrono>
@@ -10,19 +12,42 @@
 #include <numeric>
 #include <string>
 #include <filesystem>
+#include <memory>
+#include <cstdlib>
 
 // ── Workload definitions ──────────────────────────────────────────────────────
 struct WorkloadConfig {
     const char* name;
-    int read_pct;   // percentage of ops that are reads (0-100)
+    int read_pct;     // percentage of ops that are reads (0-100)
+    int cancel_pct;   // percentage of ops that cancel one of this thread's resting orders
+    int modify_pct = 0; // percentage of ops that amend one (new price and size)
+    int bad_pct = 0;    // --bad: percentage of write ops that are doomed (see worker)
 };
 
 static constexpr WorkloadConfig WORKLOADS[] = {
-    {"read_heavy",  90},
-    {"balanced",    50},
-    {"write_heavy", 20},
+    {"read_heavy",  90, 0},
+    {"balanced",    50, 0},
+    {"write_heavy", 20, 0},
 };
 
+// --cancel: same read ratios, but part of the write traffic cancels
+static constexpr WorkloadConfig CANCEL_WORKLOADS[] = {
+    {"read_heavy",  90,  5},
+    {"balanced",    50, 20},
+    {"write_heavy", 20, 40},
+};
+
+// --modify: market-making flow, roughly 70% of write traffic is amends
+static constexpr WorkloadConfig MODIFY_WORKLOADS[] = {
+    {"read_heavy",  90, 1,  7},
+    {"balanced",    50, 4, 32},
+    {"write_heavy", 20, 8, 56},
+};
+
+// --batch: adds are queued per thread and submitted with add_orders()
+// in groups of this size (1 = plain add_order)
+static constexpr int BATCH_SIZES[] = {1, 8, 32, 128};
+
 static constexpr int THREAD_COUNTS[] = {1, 2, 4, 8};
 static constexpr int OPS_PER_THREAD  = 100'000;
 
@@ -30,6 +55,8 @@ static constexpr int OPS_PER_THREAD  = 100'000;
 struct BenchResult {
     std::string workload;
     std::string policy;
+    std::string backend;
+    int         batch;
     int         threads;
     uint64_t    total_ops;
     long        throughput_ops_per_sec;
@@ -39,12 +66,19 @@ struct BenchResult {
 
 // ── Per-thread worker ─────────────────────────────────────────────────────────
 static std::atomic<uint64_t> g_next_order_id{1};
+// --bad: cancels target ids from here up, which no run reaches
+static constexpr uint64_t kNeverIssued = uint64_t{1} << 62;
+
+// --pin: CPU for worker t (-1 = unpinned). The book is built on worker 0's
+// CPU so its memory lands on that node.
+static std::vector<int> g_thread_cpus;
 
-template <typename LockPolicy>
-void worker(OrderBook<LockPolicy>* book,
+template <typename Book>
+void worker(Book* book,
             int num_ops,
             int thread_id,
-            int read_pct,
+            const WorkloadConfig& wl,
+            int batch,
             std::vector<double>& latencies)
 {
     std::mt19937 rng(static_cast<uint32_t>(thread_id) * 1234567u + 42u);
@@ -53,58 +87,131 @@ void worker(OrderBook<LockPolicy>* book,
     std::uniform_int_distribution<int>      side_dist(0, 1);
     std::uniform_int_distribution<int>      op_dist(0, 99);
 
+    // Ids this thread has resting; cancels pick one at random so they hit
+    // the front, middle and back of levels alike.
+    std::vector<uint64_t> live;
+    live.reserve(num_ops);
+
+    // Adds waiting for the next add_orders() call (batch > 1 only)
+    std::vector<Order>      pending;
+    std::unique_ptr<bool[]> status(new bool[batch]);
+    pending.reserve(batch);
+
+    // Submit the queued adds as one call; each order is charged an equal
+    // share of that call's latency.
+    auto submit_pending = [&](std::chrono::high_resolution_clock::time_point t0) {
+        book->add_orders(pending.data(), pending.size(), status.get());
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double share = std::chrono::duration<double, std::nano>(t1 - t0).count()
+                       / static_cast<double>(pending.size());
+        for (size_t k = 0; k < pending.size(); ++k) {
+            latencies.push_back(share);
+            if (status[k]) live.push_back(pending[k].id);
+        }
+        pending.clear();
+    };
+
     latencies.reserve(num_ops);
 
     for (int i = 0; i < num_ops; ++i) {
+        int op = op_dist(rng);
+        // --bad: a write op replaced by one the book must reject, alternately
+        // a cancel of an id never issued and a re-add of a resting id
+        bool bad = wl.bad_pct > 0 && op >= wl.read_pct && op_dist(rng) < wl.bad_pct;
+        size_t victim = 0;
+        if (!live.empty())
+            victim = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+
+        bool cancelled = false;   // only then does live[victim] leave the list
         auto t0 = std::chrono::high_resolution_clock::now();
 
-        if (op_dist(rng) < read_pct) {
+        if (op < wl.read_pct) {
             // Read path
             book->best_bid_price();
             book->best_ask_price();
+        } else if (bad) {
+            if (i % 2 == 0 || live.empty())
+                book->cancel_order(kNeverIssued + static_cast<uint64_t>(i));
+            else
+                book->add_order(Order::Limit(live[victim], 1, Side::BUY, price_dist(rng), qty_dist(rng)));
+        } else if (op < wl.read_pct + wl.cancel_pct && !live.empty()) {
+            // Cancel path
+            book->cancel_order(live[victim]);
+            cancelled = true;
+        } else if (op < wl.read_pct + wl.cancel_pct + wl.modify_pct && !live.empty()) {
+            // Amend path
+            book->modify_order(live[victim], price_dist(rng), qty_dist(rng));
         } else {
             // Write path
             uint64_t id    = g_next_order_id.fetch_add(1, std::memory_order_relaxed);
             Side     side  = side_dist(rng) == 0 ? Side::BUY : Side::SELL;
             uint64_t price = price_dist(rng);
             uint64_t qty   = qty_dist(rng);
-            book->add_order(Order::Limit(id, 1, side, price, qty));
+            Order    o     = Order::Limit(id, 1, side, price, qty);
+
+            if (batch > 1) {
+                pending.push_back(o);
+                if (static_cast<int>(pending.size()) == batch)
+                    submit_pending(t0);
+                continue;
+            }
+
+            if (book->add_order(o))
+                live.push_back(id);
         }
 
         auto t1 = std::chrono::high_resolution_clock::now();
         latencies.push_back(
             std::chrono::duration<double, std::nano>(t1 - t0).count());
+
+        if (cancelled) {
+            live[victim] = live.back();
+            live.pop_back();
+        }
     }
+
+    if (!pending.empty())
+        submit_pending(std::chrono::high_resolution_clock::now());
 }
 
-// ── Single benchmark run ──────────────────────────────────────────────────────
-template <typename LockPolicy>
-BenchResult run_one(const WorkloadConfig& wl,
-                    int                   num_threads,
-                    const char*           policy_name)
+// Journal replay: applies a fixed command list instead of drawing from the RNG
+template <typename Book>
+void replay_worker(Book* book,
+                   const std::vector<JournalRecord>* commands,
+                   std::vector<double>& latencies)
 {
-    OrderBook<LockPolicy> book;
-    g_next_order_id.store(1, std::memory_order_relaxed);
-
-    std::vector<std::thread>          threads;
-    std::vector<std::vector<double>>  all_latencies(num_threads);
-
-    auto wall_start = std::chrono::high_resolution_clock::now();
-
-    for (int t = 0; t < num_threads; ++t) {
-        threads.emplace_back(worker<LockPolicy>,
-                             &book, OPS_PER_THREAD, t,
-                             wl.read_pct,
-                             std::ref(all_latencies[t]));
+    latencies.reserve(commands->size());
+    for (const JournalRecord& r : *commands) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        replay(&r, &r + 1, *book);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        latencies.push_back(
+            std::chrono::duration<double, std::nano>(t1 - t0).count());
     }
-    for (auto& th : threads) th.join();
+}
 
-    auto wall_end   = std::chrono::high_resolution_clock::now();
-    double elapsed  = std::chrono::duration<double>(wall_end - wall_start).count();
+// Split a journal across threads by order id, so each order's add and
+// cancel stay on one thread in their recorded order.
+static std::vector<std::vector<JournalRecord>>
+partition_journal(const JournalReader& journal, int num_threads)
+{
+    std::vector<std::vector<JournalRecord>> parts(num_threads);
+    for (const JournalRecord& r : journal)
+        parts[r.order_id % num_threads].push_back(r);
+    return parts;
+}
 
+// ── Latency aggregation ───────────────────────────────────────────────────────
+static BenchResult summarize(const char* workload,
+                             const char* policy_name,
+                             const char* backend_name,
+                             int         batch,
+                             int         num_threads,
+                             const std::vector<std::vector<double>>& all_latencies,
+                             double      elapsed)
+{
     // Aggregate and sort latencies
     std::vector<double> flat;
-    flat.reserve(static_cast<size_t>(num_threads) * OPS_PER_THREAD);
     for (auto& v : all_latencies)
         flat.insert(flat.end(), v.begin(), v.end());
 
@@ -115,8 +222,10 @@ BenchResult run_one(const WorkloadConfig& wl,
     double p99 = flat[static_cast<size_t>(flat.size() * 99 / 100)];
 
     BenchResult r;
-    r.workload              = wl.name;
+    r.workload              = workload;
     r.policy                = policy_name;
+    r.backend               = backend_name;
+    r.batch                 = batch;
     r.threads               = num_threads;
     r.total_ops             = flat.size();
     r.throughput_ops_per_sec= static_cast<long>(flat.size() / elapsed);
@@ -125,50 +234,286 @@ BenchResult run_one(const WorkloadConfig& wl,
     return r;
 }
 
+// ── Book instrumentation (--stats) ────────────────────────────────────────────
+static void print_book_stats(const BookStatsSnapshot& st)
+{
+    static const char* OP_NAMES[kBookOps] = {"add", "cancel", "modify", "batch"};
+    double tpn = ticks_per_ns();
+    auto ns = [tpn](uint64_t ticks) { return static_cast<long>(ticks / tpn); };
+
+    for (int op = 0; op < kBookOps; ++op) {
+        const LogHistogram& w = st.wait[op];
+        const LogHistogram& h = st.hold[op];
+        if (h.count() == 0) continue;
+        std::cout << "      " << OP_NAMES[op] << ": n=" << h.count()
+                  << " | wait p50=" << ns(w.percentile(50)) << " p99=" << ns(w.percentile(99))
+                  << " ns | hold p50=" << ns(h.percentile(50)) << " p99=" << ns(h.percentile(99))
+                  << " ns\n";
+    }
+    std::cout << "      match: n=" << st.match.count()
+              << " p99=" << ns(st.match.percentile(99)) << " ns"
+              << " | fills=" << st.fills
+              << " | levels +" << st.levels_created << " -" << st.levels_erased
+              << " | cancel level depth p99=" << st.cancel_depth.percentile(99) << "\n";
+}
+
+// ── Single benchmark run ──────────────────────────────────────────────────────
+template <typename LockPolicy, typename Levels, typename Stats = NoStatsPolicy>
+BenchResult run_one(const WorkloadConfig& wl,
+                    int                   num_threads,
+                    int                   batch,
+                    const char*           policy_name,
+                    const char*           backend_name)
+{
+    using Book = OrderBook<LockPolicy, Levels, Stats>;
+    auto book = run_on_cpu(g_thread_cpus[0], [] { return std::make_unique<Book>(); });
+    g_next_order_id.store(1, std::memory_order_relaxed);
+
+    std::vector<std::thread>          threads;
+    std::vector<std::vector<double>>  all_latencies(num_threads);
+
+    auto wall_start = std::chrono::high_resolution_clock::now();
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            pin_current_thread(g_thread_cpus[t]);
+            worker<Book>(book.get(), OPS_PER_THREAD, t, wl, batch, all_latencies[t]);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto wall_end   = std::chrono::high_resolution_clock::now();
+    double elapsed  = std::chrono::duration<double>(wall_end - wall_start).count();
+
+    if constexpr (Stats::enabled)
+        print_book_stats(book->stats().snapshot());
+
+    return summarize(wl.name, policy_name, backend_name, batch, num_threads,
+                     all_latencies, elapsed);
+}
+
+template <typename LockPolicy, typename Levels>
+BenchResult run_replay(const JournalReader& journal,
+                       int                  num_threads,
+                       const char*          policy_name,
+                       const char*          backend_name)
+{
+    using Book = OrderBook<LockPolicy, Levels>;
+    auto book = run_on_cpu(g_thread_cpus[0], [] { return std::make_unique<Book>(); });
+    auto parts = partition_journal(journal, num_threads);
+
+    std::vector<std::thread>          threads;
+    std::vector<std::vector<double>>  all_latencies(num_threads);
+
+    auto wall_start = std::chrono::high_resolution_clock::now();
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            pin_current_thread(g_thread_cpus[t]);
+            replay_worker<Book>(book.get(), &parts[t], all_latencies[t]);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto wall_end   = std::chrono::high_resolution_clock::now();
+    double elapsed  = std::chrono::duration<double>(wall_end - wall_start).count();
+
+    return summarize("journal", policy_name, backend_name, 1, num_threads,
+                     all_latencies, elapsed);
+}
+
 // ── Main ──────────────────────────────────────────────────────────────────────
-int main()
+int main(int argc, char** argv)
 {
+    bool cancel_mode = false;
+    bool modify_mode = false;
+    bool batch_mode  = false;
+    bool stats_mode  = false;   // --stats: instrumented books, prints lock wait/hold
+    std::string journal_path;   // --journal: replay this instead of the RNG
+    std::string record_path;    // --record: write a journal and exit
+    int bad_pct = 0;            // --bad: share of write ops that must be rejected
+    Placement placement = Placement::NONE;   // --pin: worker thread layout
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--cancel") {
+            cancel_mode = true;
+        } else if (arg == "--modify") {
+            modify_mode = true;
+        } else if (arg == "--batch") {
+            batch_mode = true;
+        } else if (arg == "--stats") {
+            stats_mode = true;
+        } else if (arg == "--journal" && i + 1 < argc) {
+            journal_path = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (arg == "--bad" && i + 1 < argc) {
+            bad_pct = std::clamp(std::atoi(argv[++i]), 0, 100);
+        } else if (arg == "--pin" && i + 1 < argc && parse_placement(argv[i + 1], placement)) {
+            ++i;
+        } else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--cancel | --modify] [--batch] [--stats] [--journal FILE | --record FILE]"
+                         " [--pin none|compact|smt|socket|cross] [--bad PCT]\n";
+            return 1;
+        }
+    }
+
+    CpuTopology topo = CpuTopology::detect();
+    g_thread_cpus = plan_threads(topo, placement,
+                                 *std::max_element(std::begin(THREAD_COUNTS), std::end(THREAD_COUNTS)));
+
+    // --record: one thread of the write-heavy workload, every accepted
+    // add/cancel journaled. Replaying the file gives the same command
+    // stream on every run.
+    if (!record_path.empty()) {
+        const auto& wl = modify_mode ? MODIFY_WORKLOADS[2]
+                       : cancel_mode ? CANCEL_WORKLOADS[2] : WORKLOADS[2];
+        OrderBook<MutexPolicy, MapLevels> book;
+        JournalWriter journal(record_path);
+        book.set_journal(&journal);
+
+        std::vector<double> latencies;
+        worker(&book, OPS_PER_THREAD, 0, wl, 1, latencies);
+        book.set_journal(nullptr);
+        journal.flush();
+
+        std::cout << "Recorded " << journal.records_written() << " commands ("
+                  << wl.name << (cancel_mode ? ", cancel" : "")
+                  << (modify_mode ? ", modify" : "")
+                  << ") → " << record_path << "\n";
+        return 0;
+    }
+
+    // --batch sweeps BATCH_SIZES on the write-heavy workload only
+    std::vector<WorkloadConfig> workloads;
+    for (const auto& wl : modify_mode ? MODIFY_WORKLOADS
+                        : cancel_mode ? CANCEL_WORKLOADS : WORKLOADS)
+        if (!batch_mode || std::string(wl.name) == "write_heavy") {
+            workloads.push_back(wl);
+            workloads.back().bad_pct = bad_pct;
+        }
+
+    std::vector<int> batch_sizes{1};
+    if (batch_mode)
+        batch_sizes.assign(std::begin(BATCH_SIZES), std::end(BATCH_SIZES));
+
+    std::string csv_path = "results/benchmark_results";
+    if (!journal_path.empty()) csv_path += "_journal";
+    if (cancel_mode) csv_path += "_cancel";
+    if (modify_mode) csv_path += "_modify";
+    if (batch_mode)  csv_path += "_batch";
+    if (stats_mode)  csv_path += "_stats";
+    if (bad_pct > 0) csv_path += "_bad" + std::to_string(bad_pct);
+    if (placement != Placement::NONE)
+        csv_path += std::string("_pin_") + placement_name(placement);
+    csv_path += ".csv";
+
     std::vector<BenchResult> results;
-    results.reserve(24);   // 3 workloads × 4 thread_counts × 2 policies
+    results.reserve(72);   // 3 workloads × 4 thread_counts × 3 policies × 2 backends
+
+    auto print = [](const BenchResult& r) {
+        std::cout << "  [" << r.policy << " / " << r.backend << "]"
+                  << " batch="   << r.batch
+                  << " threads=" << r.threads
+                  << " | ops="   << r.total_ops
+                  << " | tput="  << r.throughput_ops_per_sec << " ops/s"
+                  << " | avg="   << r.avg_latency_ns << " ns"
+                  << " | p99="   << r.p99_latency_ns << " ns"
+                  << "\n";
+    };
 
     std::cout << "========================================\n"
-              << "Benchmark Comparison: Mutex vs SharedMutex\n"
-              << "ops_per_thread=" << OPS_PER_THREAD << "\n"
-              << "========================================\n\n";
+              << "Benchmark Comparison: Mutex vs SharedMutex vs SeqLock (MapLevels, TickLadder)\n"
+              << "ops_per_thread=" << OPS_PER_THREAD
+              << (cancel_mode ? " mode=cancel" : "")
+              << (modify_mode ? " mode=modify" : "")
+              << (batch_mode ? " mode=batch" : "")
+              << (bad_pct > 0 ? " bad=" + std::to_string(bad_pct) + "%" : "") << "\n"
+              << "placement=" << placement_name(placement) << " (" << topo.cpus().size()
+              << " cpus, " << topo.sockets() << " sockets, " << topo.nodes() << " nodes)";
+    if (placement != Placement::NONE) {
+        std::cout << " workers→cpu";
+        for (int cpu : g_thread_cpus) {
+            const CpuInfo* c = topo.find(cpu);
+            std::cout << " " << cpu << "[s" << c->socket << "/c" << c->core << "]";
+        }
+    }
+    std::cout << "\n========================================\n\n";
 
-    for (const auto& wl : WORKLOADS) {
+    // --journal: the recorded commands, split by order id across threads
+    std::unique_ptr<JournalReader> journal;
+    if (!journal_path.empty()) {
+        journal = std::make_unique<JournalReader>(journal_path);
+        std::cout << "=== Workload: journal " << journal_path
+                  << " (" << journal->size() << " commands) ===\n";
+        for (int tc : THREAD_COUNTS) {
+            BenchResult batch[] = {
+                run_replay<MutexPolicy,       MapLevels> (*journal, tc, "MutexPolicy",       "MapLevels"),
+                run_replay<SharedMutexPolicy, MapLevels> (*journal, tc, "SharedMutexPolicy", "MapLevels"),
+                run_replay<SeqLockPolicy,     MapLevels> (*journal, tc, "SeqLockPolicy",     "MapLevels"),
+                run_replay<MutexPolicy,       TickLadder>(*journal, tc, "MutexPolicy",       "TickLadder"),
+                run_replay<SharedMutexPolicy, TickLadder>(*journal, tc, "SharedMutexPolicy", "TickLadder"),
+                run_replay<SeqLockPolicy,     TickLadder>(*journal, tc, "SeqLockPolicy",     "TickLadder"),
+            };
+            for (const auto& r : batch) {
+                print(r);
+                results.push_back(r);
+            }
+        }
+        std::cout << "\n";
+        workloads.clear();
+    }
+
+    for (const auto& wl : workloads) {
+        int add_pct = 100 - wl.read_pct - wl.cancel_pct - wl.modify_pct;
         std::cout << "=== Workload: " << wl.name
-                  << " (read=" << wl.read_pct << "% write=" << (100 - wl.read_pct) << "%) ===\n";
+                  << " (read=" << wl.read_pct << "% add=" << add_pct
+                  << "% cancel=" << wl.cancel_pct << "% modify=" << wl.modify_pct
+                  << "%) ===\n";
 
+        for (int bs : batch_sizes)
         for (int tc : THREAD_COUNTS) {
-            auto r1 = run_one<MutexPolicy>      (wl, tc, "MutexPolicy");
-            auto r2 = run_one<SharedMutexPolicy>(wl, tc, "SharedMutexPolicy");
-            results.push_back(r1);
-            results.push_back(r2);
-
-            auto print = [](const BenchResult& r) {
-                std::cout << "  [" << r.policy << "]"
-                          << " threads=" << r.threads
-                          << " | ops="   << r.total_ops
-                          << " | tput="  << r.throughput_ops_per_sec << " ops/s"
-                          << " | avg="   << r.avg_latency_ns << " ns"
-                          << " | p99="   << r.p99_latency_ns << " ns"
-                          << "\n";
+            std::vector<BenchResult> batch;
+            if (stats_mode) {
+                // Each result's instrumentation is printed before its summary line
+                using HS = HistogramStatsPolicy;
+                batch.push_back(run_one<MutexPolicy,       TickLadder, HS>(wl, tc, bs, "MutexPolicy",       "TickLadder"));
+                print(batch.back());
+                batch.push_back(run_one<SharedMutexPolicy, TickLadder, HS>(wl, tc, bs, "SharedMutexPolicy", "TickLadder"));
+                print(batch.back());
+                batch.push_back(run_one<SeqLockPolicy,     TickLadder, HS>(wl, tc, bs, "SeqLockPolicy",     "TickLadder"));
+                print(batch.back());
+                results.insert(results.end(), batch.begin(), batch.end());
+                continue;
+            }
+            batch = {
+                run_one<MutexPolicy,       MapLevels> (wl, tc, bs, "MutexPolicy",       "MapLevels"),
+                run_one<SharedMutexPolicy, MapLevels> (wl, tc, bs, "SharedMutexPolicy", "MapLevels"),
+                run_one<SeqLockPolicy,     MapLevels> (wl, tc, bs, "SeqLockPolicy",     "MapLevels"),
+                run_one<MutexPolicy,       TickLadder>(wl, tc, bs, "MutexPolicy",       "TickLadder"),
+                run_one<SharedMutexPolicy, TickLadder>(wl, tc, bs, "SharedMutexPolicy", "TickLadder"),
+                run_one<SeqLockPolicy,     TickLadder>(wl, tc, bs, "SeqLockPolicy",     "TickLadder"),
             };
-            print(r1);
-            print(r2);
+
+            for (const auto& r : batch) {
+                print(r);
+                results.push_back(r);
+            }
         }
         std::cout << "\n";
     }
 
     // ── CSV output ────────────────────────────────────────────────────────────
     std::filesystem::create_directories("results");
-    std::ofstream csv("results/benchmark_results.csv");
-    csv << "workload,policy,threads,total_ops,"
+    std::ofstream csv(csv_path);
+    csv << "workload,policy,backend,batch,threads,total_ops,"
            "throughput_ops_per_sec,avg_latency_ns,p99_latency_ns\n";
     for (const auto& r : results) {
         csv << r.workload              << ","
             << r.policy               << ","
+            << r.backend              << ","
+            << r.batch                << ","
             << r.threads              << ","
             << r.total_ops            << ","
             << r.throughput_ops_per_sec << ","
@@ -176,7 +521,7 @@ int main()
             << r.p99_latency_ns       << "\n";
     }
 
-    std::cout << "Results saved → results/benchmark_results.csv\n"
+    std::cout << "Results saved → " << csv_path << "\n"
               << "Total rows: " << results.size() << "\n";
     return 0;
 }
@@ -0,0 +1,155 @@
+#include "lock_policy.h"
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <filesystem>
+
+// ── Sweep definition ──────────────────────────────────────────────────────────
+// Each op takes the policy's read or write lock and then burns `cs_iters`
+// iterations of dependent arithmetic while holding it. Sweeping cs_iters
+// from "one map lookup" to "building a snapshot" shows where the cheaper
+// exclusive locks stop winning and reader concurrency starts paying off.
+static constexpr int CS_ITERS[]      = {0, 100, 1000, 10000};
+static constexpr int THREAD_COUNTS[] = {1, 2, 4, 8};
+static constexpr int OPS_PER_THREAD  = 20'000;
+static constexpr int READ_PCT        = 90;
+
+// ── Result record ─────────────────────────────────────────────────────────────
+struct CrossoverResult {
+    std::string policy;
+    int         cs_iters;
+    int         threads;
+    long        throughput_ops_per_sec;
+    long        avg_latency_ns;
+    long        p99_latency_ns;
+};
+
+// ── Critical-section body ─────────────────────────────────────────────────────
+static inline uint64_t burn(uint64_t x, int iters)
+{
+    for (int i = 0; i < iters; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        asm volatile("" : "+r"(x));
+    }
+    return x;
+}
+
+template <typename LockPolicy>
+struct SharedState {
+    typename LockPolicy::mutex_type mtx;
+    uint64_t data[8] = {};
+};
+
+template <typename LockPolicy>
+void worker(SharedState<LockPolicy>* state,
+            int cs_iters,
+            int thread_id,
+            std::vector<double>& latencies)
+{
+    std::mt19937 rng(static_cast<uint32_t>(thread_id) * 1234567u + 42u);
+    std::uniform_int_distribution<int> op_dist(0, 99);
+    uint64_t sink = 0;
+
+    latencies.reserve(OPS_PER_THREAD);
+
+    for (int i = 0; i < OPS_PER_THREAD; ++i) {
+        bool is_read = op_dist(rng) < READ_PCT;
+        auto t0 = std::chrono::steady_clock::now();
+
+        if (is_read) {
+            typename LockPolicy::read_lock lk(state->mtx);
+            sink += burn(state->data[i & 7], cs_iters);
+        } else {
+            typename LockPolicy::write_lock lk(state->mtx);
+            state->data[i & 7] = burn(state->data[i & 7] + 1, cs_iters);
+        }
+
+        auto t1 = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+    asm volatile("" : : "r"(sink));
+}
+
+template <typename LockPolicy>
+CrossoverResult run_one(const char* policy_name, int cs_iters, int num_threads)
+{
+    SharedState<LockPolicy> state;
+    std::vector<std::thread>         threads;
+    std::vector<std::vector<double>> all_latencies(num_threads);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < num_threads; ++t)
+        threads.emplace_back(worker<LockPolicy>, &state, cs_iters, t,
+                             std::ref(all_latencies[t]));
+    for (auto& th : threads) th.join();
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> flat;
+    for (auto& v : all_latencies)
+        flat.insert(flat.end(), v.begin(), v.end());
+    std::sort(flat.begin(), flat.end());
+
+    double avg = std::accumulate(flat.begin(), flat.end(), 0.0) / flat.size();
+    double p99 = flat[flat.size() * 99 / 100];
+
+    return {policy_name, cs_iters, num_threads,
+            static_cast<long>(flat.size() / elapsed),
+            static_cast<long>(avg), static_cast<long>(p99)};
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main()
+{
+    std::cout << "========================================\n"
+              << "Lock Crossover Sweep (read=" << READ_PCT << "%)\n"
+              << "ops_per_thread=" << OPS_PER_THREAD << "\n"
+              << "========================================\n\n";
+
+    std::vector<CrossoverResult> results;
+
+    for (int cs : CS_ITERS) {
+        std::cout << "=== Critical section: " << cs << " iterations ===\n";
+        for (int tc : THREAD_COUNTS) {
+            CrossoverResult batch[] = {
+                run_one<MutexPolicy>       ("MutexPolicy",        cs, tc),
+                run_one<SharedMutexPolicy> ("SharedMutexPolicy",  cs, tc),
+                run_one<SpinLockPolicy>    ("SpinLockPolicy",     cs, tc),
+                run_one<TicketLockPolicy>  ("TicketLockPolicy",   cs, tc),
+                run_one<AdaptiveLockPolicy>("AdaptiveLockPolicy", cs, tc),
+            };
+            for (const auto& r : batch) {
+                std::cout << "  [" << r.policy << "]"
+                          << " threads=" << r.threads
+                          << " | tput="  << r.throughput_ops_per_sec << " ops/s"
+                          << " | avg="   << r.avg_latency_ns << " ns"
+                          << " | p99="   << r.p99_latency_ns << " ns\n";
+                results.push_back(r);
+            }
+        }
+        std::cout << "\n";
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/crossover_results.csv");
+    csv << "policy,cs_iters,threads,throughput_ops_per_sec,avg_latency_ns,p99_latency_ns\n";
+    for (const auto& r : results) {
+        csv << r.policy   << ","
+            << r.cs_iters << ","
+            << r.threads  << ","
+            << r.throughput_ops_per_sec << ","
+            << r.avg_latency_ns << ","
+            << r.p99_latency_ns << "\n";
+    }
+
+    std::cout << "Results saved → results/crossover_results.csv\n"
+              << "Total rows: " << results.size() << "\n";
+    return 0;
+}
@@ -0,0 +1,597 @@
+#include "order_book.h"
+#include "flow_generator.h"
+#include "level_scan.h"
+#include "perf_counters.h"
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+// ── Harness ───────────────────────────────────────────────────────────────────
+// Small Google-Benchmark-style runner: each benchmark is registered with a
+// name and an argument, runs `iters` operations and returns the nanoseconds
+// it spent on the timed part (setup is its own business). The runner grows
+// iters until one run takes MIN_RUN_NS, then reports the median of
+// REPETITIONS runs. With --counters, hardware counters (perf_counters.h)
+// run over exactly the timed parts (start_timer() to elapsed_ns()) and are
+// reported per op, averaged over the REPETITIONS runs. Off by default:
+// starting and stopping them is a system call, which in a VM can cost tens
+// of microseconds and makes benchmarks that time many short stretches take
+// many times longer (the times themselves are unaffected).
+static constexpr double MIN_RUN_NS  = 50e6;
+static constexpr int    REPETITIONS = 5;
+static constexpr size_t MAX_ITERS   = size_t{1} << 22;
+
+using Clock = std::chrono::steady_clock;
+using BenchFn = std::function<double(size_t iters)>;
+
+struct MicroBenchmark {
+    std::string name;
+    std::string backend;
+    long        arg;
+    BenchFn     fn;
+};
+
+struct MicroResult {
+    std::string name;
+    std::string backend;
+    long        arg;
+    size_t      iterations;
+    double      ns_per_op;
+    double      ops_per_sec;
+    double      insns_per_op;
+    double      cycles_per_op;
+    double      branches_per_op;
+    double      misses_per_op;   // branch misses
+};
+
+static std::unique_ptr<PerfCounters> g_counters;   // set by --counters
+
+static Clock::time_point start_timer()
+{
+    if (g_counters) g_counters->start();
+    return Clock::now();
+}
+
+static double elapsed_ns(Clock::time_point t0)
+{
+    auto t1 = Clock::now();
+    if (g_counters) g_counters->stop();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+static MicroResult run_benchmark(const MicroBenchmark& b)
+{
+    size_t iters = 1;
+    while (iters < MAX_ITERS && b.fn(iters) < MIN_RUN_NS)
+        iters *= 4;
+
+    std::vector<double> per_op;
+    if (g_counters) g_counters->reset();
+    for (int r = 0; r < REPETITIONS; ++r)
+        per_op.push_back(b.fn(iters) / static_cast<double>(iters));
+    std::sort(per_op.begin(), per_op.end());
+    double ns = per_op[per_op.size() / 2];
+
+    PerfCounts c = g_counters ? g_counters->read() : PerfCounts{};
+    double ops = static_cast<double>(iters) * REPETITIONS;
+    return {b.name, b.backend, b.arg, iters, ns, 1e9 / ns,
+            static_cast<double>(c.instructions) / ops, static_cast<double>(c.cycles) / ops,
+            static_cast<double>(c.branches) / ops, static_cast<double>(c.branch_misses) / ops};
+}
+
+// ── Microbenchmarks ───────────────────────────────────────────────────────────
+// Single-threaded books (MutexPolicy: uncontended lock, like production with
+// one writer). Prices stay inside the default TickLadder band.
+template <typename Levels>
+using Book = OrderBook<MutexPolicy, Levels>;
+
+// Resting adds spread over 64 levels per side, none crossing.
+template <typename Levels>
+double bm_add(size_t iters)
+{
+    Book<Levels> book;
+    auto t0 = start_timer();
+    for (size_t i = 0; i < iters; ++i) {
+        bool buy = i & 1;
+        uint64_t price = buy ? 9999 - (i >> 1) % 64 : 10001 + (i >> 1) % 64;
+        book.add_order(Order::Limit(i + 1, 1, buy ? Side::BUY : Side::SELL, price, 10));
+    }
+    return elapsed_ns(t0);
+}
+
+// Cancel from one level of `depth` orders. Which order goes next:
+// front = oldest, back = newest, middle = alternating out from the centre.
+enum class CancelAt { FRONT, MIDDLE, BACK };
+
+static std::vector<uint64_t> cancel_sequence(size_t depth, CancelAt where)
+{
+    std::vector<uint64_t> ids;
+    ids.reserve(depth);
+    if (where == CancelAt::FRONT) {
+        for (size_t i = 1; i <= depth; ++i) ids.push_back(i);
+    } else if (where == CancelAt::BACK) {
+        for (size_t i = depth; i >= 1; --i) ids.push_back(i);
+    } else {
+        size_t mid = depth / 2 + 1;
+        ids.push_back(mid);
+        for (size_t k = 1; ids.size() < depth; ++k) {
+            if (mid + k <= depth) ids.push_back(mid + k);
+            if (mid > k && ids.size() < depth) ids.push_back(mid - k);
+        }
+    }
+    return ids;
+}
+
+template <typename Levels>
+double bm_cancel(size_t iters, size_t depth, CancelAt where)
+{
+    auto seq = cancel_sequence(depth, where);
+    Book<Levels> book;
+    double ns = 0;
+    for (size_t done = 0; done < iters; done += depth) {
+        for (size_t i = 1; i <= depth; ++i)
+            book.add_order(Order::Limit(i, 1, Side::BUY, 9990, 10));
+        size_t n = std::min(depth, iters - done);
+        auto t0 = start_timer();
+        for (size_t i = 0; i < n; ++i)
+            book.cancel_order(seq[i]);
+        ns += elapsed_ns(t0);
+        for (size_t i = n; i < depth; ++i)
+            book.cancel_order(seq[i]);
+    }
+    return ns;
+}
+
+// One market order consuming `levels` price levels of 4 orders each.
+// Reported per sweep.
+template <typename Levels>
+double bm_market_sweep(size_t iters, size_t levels)
+{
+    Book<Levels> book;
+    uint64_t id = 1;
+    double ns = 0;
+    for (size_t i = 0; i < iters; ++i) {
+        for (size_t l = 0; l < levels; ++l)
+            for (int k = 0; k < 4; ++k)
+                book.add_order(Order::Limit(id++, 1, Side::SELL, 10001 + l, 10));
+        auto t0 = start_timer();
+        book.add_order(Order::Market(id++, 1, Side::BUY, levels * 40));
+        ns += elapsed_ns(t0);
+    }
+    return ns;
+}
+
+// top_of_book() on a book with 64 levels per side.
+template <typename LockPolicy, typename Levels>
+double bm_top_of_book(size_t iters)
+{
+    OrderBook<LockPolicy, Levels> book;
+    for (uint64_t i = 0; i < 64; ++i) {
+        book.add_order(Order::Limit(2 * i + 1, 1, Side::BUY, 9999 - i, 10));
+        book.add_order(Order::Limit(2 * i + 2, 1, Side::SELL, 10001 + i, 10));
+    }
+    uint64_t sink = 0;
+    auto t0 = start_timer();
+    for (size_t i = 0; i < iters; ++i)
+        sink += book.top_of_book().bid_qty;
+    double ns = elapsed_ns(t0);
+    asm volatile("" : : "r"(sink));
+    return ns;
+}
+
+// Replay of a generated flow on a single-threaded book, per command.
+template <typename Levels>
+double bm_flow(size_t iters, const FlowConfig& cfg)
+{
+    auto flow = FlowGenerator(cfg).generate(iters);
+    OrderBook<NullLockPolicy, Levels> book;
+    auto t0 = start_timer();
+    replay(flow.data(), flow.data() + flow.size(), book);
+    return elapsed_ns(t0);
+}
+
+// ── Order-id index ────────────────────────────────────────────────────────────
+// OrderIndex against the std::unordered_map it replaced, both unreserved as
+// in the book, with `live` orders resting. Ids are increasing (as the book
+// sees them) or random 64-bit (table only, no dense window).
+struct StdIndex {
+    std::unordered_map<uint64_t, OrderNode*> map;
+
+    OrderNode* find(uint64_t id) const {
+        auto it = map.find(id);
+        return it == map.end() ? nullptr : it->second;
+    }
+    bool insert(uint64_t id, OrderNode* node) { return map.emplace(id, node).second; }
+    OrderNode* extract(uint64_t id) {
+        auto it = map.find(id);
+        if (it == map.end()) return nullptr;
+        OrderNode* node = it->second;
+        map.erase(it);
+        return node;
+    }
+};
+
+static uint64_t xorshift(uint64_t& s)
+{
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+enum class IndexOp { FIND, CHURN };
+
+template <typename Index>
+double bm_index(size_t iters, size_t live, IndexOp op, bool random_ids)
+{
+    static OrderNode node;
+    Index index;
+    std::vector<uint64_t> ids(live);
+    uint64_t rng = 88172645463325252ull;
+    uint64_t next_id = 1;
+    auto new_id = [&] { return random_ids ? xorshift(rng) : next_id++; };
+    for (auto& id : ids) {
+        id = new_id();
+        index.insert(id, &node);
+    }
+
+    uint64_t sink = 0;
+    auto t0 = start_timer();
+    for (size_t i = 0; i < iters; ++i) {
+        size_t k = xorshift(rng) % live;
+        if (op == IndexOp::FIND) {
+            sink += reinterpret_cast<uintptr_t>(index.find(ids[k]));
+        } else {
+            // Cancel a random resting order, add a new one
+            sink += reinterpret_cast<uintptr_t>(index.extract(ids[k]));
+            ids[k] = new_id();
+            index.insert(ids[k], &node);
+        }
+    }
+    double ns = elapsed_ns(t0);
+    asm volatile("" : : "r"(sink));
+    return ns;
+}
+
+static constexpr size_t INDEX_LIVE = size_t{1} << 20;
+
+template <typename Index>
+static void register_index(std::vector<MicroBenchmark>& out, const char* backend)
+{
+    long live = static_cast<long>(INDEX_LIVE);
+    out.push_back({"index_find", backend, live,
+                   [](size_t n) { return bm_index<Index>(n, INDEX_LIVE, IndexOp::FIND, false); }});
+    out.push_back({"index_churn", backend, live,
+                   [](size_t n) { return bm_index<Index>(n, INDEX_LIVE, IndexOp::CHURN, false); }});
+    out.push_back({"index_find_random_ids", backend, live,
+                   [](size_t n) { return bm_index<Index>(n, INDEX_LIVE, IndexOp::FIND, true); }});
+    out.push_back({"index_churn_random_ids", backend, live,
+                   [](size_t n) { return bm_index<Index>(n, INDEX_LIVE, IndexOp::CHURN, true); }});
+}
+
+// ── Level scans ───────────────────────────────────────────────────────────────
+// "How much rests through price P" over `levels` consecutive ask levels,
+// summed all the way (enough = max): by walking the levels best first
+// (for_each_from_best: map nodes, or 32-byte ladder levels via the bitmap)
+// or by quantity_through() (the ladder's kernel sum over its quantity array).
+enum class LevelScan { WALK, THROUGH };
+
+template <typename Levels>
+static double bm_level_sum(size_t iters, size_t levels, LevelScan how)
+{
+    typename Levels::template side<Side::SELL> side;
+    for (size_t l = 0; l < levels; ++l) {
+        uint64_t price = 10001 + l;
+        PriceLevel& level = side.level(price);
+        level.quantity = 10 + l % 7;
+        side.set_quantity(price, level.quantity);
+    }
+    uint64_t last = 10001 + levels - 1, sink = 0;
+    auto t0 = start_timer();
+    for (size_t i = 0; i < iters; ++i) {
+        if (how == LevelScan::THROUGH) {
+            sink += side.quantity_through(last, UINT64_MAX);
+        } else {
+            uint64_t total = 0;
+            side.for_each_from_best(SIZE_MAX, [&](uint64_t p, const PriceLevel& level) {
+                if (p > last) return false;
+                total += level.quantity;
+                return true;
+            });
+            sink += total;
+        }
+        asm volatile("" : "+r"(sink));
+    }
+    return elapsed_ns(t0);
+}
+
+// The kernel alone over a quantity array: the full sum of n levels.
+static double bm_kernel_sum(size_t iters, const LevelScanKernels& k, size_t n)
+{
+    std::vector<uint64_t> q(n, 10);
+    uint64_t sink = 0;
+    auto t0 = start_timer();
+    for (size_t i = 0; i < iters; ++i) {
+        sink += k.sum_until(q.data(), n, UINT64_MAX);
+        asm volatile("" : "+r"(sink));
+    }
+    return elapsed_ns(t0);
+}
+
+// Next non-empty level `gap` ticks past the best, as the book finds it:
+// ++iterator on the map, the bitmap search on the ladder.
+template <typename Levels>
+static double bm_level_next(size_t iters, size_t gap)
+{
+    typename Levels::template side<Side::SELL> side;
+    side.level(10001).quantity = 10;
+    side.level(10001 + gap).quantity = 10;
+    uint64_t sink = 0;
+    auto t0 = start_timer();
+    for (size_t i = 0; i < iters; ++i) {
+        side.for_each_from_best(2, [&](uint64_t p, const PriceLevel&) { sink += p; });
+        asm volatile("" : "+r"(sink));
+    }
+    return elapsed_ns(t0);
+}
+
+static constexpr size_t SCAN_LEVELS[] = {16, 64, 256, 1024, 4096};
+static constexpr size_t SCAN_GAPS[]   = {8, 64, 512, 4096};
+
+static void register_level_scans(std::vector<MicroBenchmark>& out)
+{
+    for (size_t levels : SCAN_LEVELS) {
+        long l = static_cast<long>(levels);
+        out.push_back({"level_sum_walk", "MapLevels", l,
+                       [levels](size_t n) { return bm_level_sum<MapLevels>(n, levels, LevelScan::WALK); }});
+        out.push_back({"level_sum_walk", "TickLadder", l,
+                       [levels](size_t n) { return bm_level_sum<TickLadder>(n, levels, LevelScan::WALK); }});
+        out.push_back({"level_sum_through", "TickLadder", l,
+                       [levels](size_t n) { return bm_level_sum<TickLadder>(n, levels, LevelScan::THROUGH); }});
+        for (const LevelScanKernels& k : available_level_scan_kernels())
+            out.push_back({"kernel_sum", k.isa, l,
+                           [k, levels](size_t n) { return bm_kernel_sum(n, k, levels); }});
+    }
+    for (size_t gap : SCAN_GAPS) {
+        long g = static_cast<long>(gap);
+        out.push_back({"level_next", "MapLevels", g,
+                       [gap](size_t n) { return bm_level_next<MapLevels>(n, gap); }});
+        out.push_back({"level_next", "TickLadder", g,
+                       [gap](size_t n) { return bm_level_next<TickLadder>(n, gap); }});
+    }
+}
+
+// ── Snapshot / load ───────────────────────────────────────────────────────────
+// Rebuilding a book of `orders` resting orders (512 levels per side) three
+// ways: load() from a snapshot, replaying the same orders through
+// add_order(), and taking the snapshot. Reported per order; a run of iters
+// covers whole rebuilds and is scaled to iters.
+enum class Rebuild { LOAD, REPLAY, SNAPSHOT };
+
+template <typename Levels>
+static const BookSnapshot& snapshot_image(size_t orders)
+{
+    static std::unordered_map<size_t, BookSnapshot> images;
+    auto it = images.find(orders);
+    if (it != images.end()) return it->second;
+
+    Book<Levels> book;
+    for (uint64_t i = 0; i < orders; ++i) {
+        Side side = i % 2 ? Side::SELL : Side::BUY;
+        uint64_t offset = (i / 2) % 512;
+        uint64_t price = side == Side::BUY ? 9999 - offset : 10001 + offset;
+        book.add_order(Order::Limit(i + 1, 1, side, price, 1 + i % 100));
+    }
+    book.snapshot(images[orders]);
+    return images[orders];
+}
+
+template <typename Levels>
+double bm_rebuild(size_t iters, size_t orders, Rebuild how)
+{
+    const BookSnapshot& image = snapshot_image<Levels>(orders);
+    size_t rounds = std::max<size_t>(1, iters / orders);
+    BookSnapshot out;
+    double ns = 0;
+    for (size_t r = 0; r < rounds; ++r) {
+        Book<Levels> book;
+        if (how == Rebuild::SNAPSHOT) {
+            book.load(image);
+            auto t0 = start_timer();
+            book.snapshot(out);
+            ns += elapsed_ns(t0);
+        } else if (how == Rebuild::LOAD) {
+            auto t0 = start_timer();
+            book.load(image);
+            ns += elapsed_ns(t0);
+        } else {
+            auto t0 = start_timer();
+            for (size_t k = 0; k < image.orders.size(); ++k) {
+                const SnapshotOrder& o = image.orders[k];
+                book.add_order(Order::Limit(o.id, o.symbol_id, k < image.bid_orders ? Side::BUY : Side::SELL,
+                                            o.price, o.visible));
+            }
+            ns += elapsed_ns(t0);
+        }
+    }
+    return ns * static_cast<double>(iters) / static_cast<double>(rounds * orders);
+}
+
+// ── Registry ──────────────────────────────────────────────────────────────────
+static constexpr size_t CANCEL_DEPTHS[] = {16, 1024};
+static constexpr size_t SWEEP_LEVELS[]  = {1, 4, 16, 64};
+static constexpr size_t SNAPSHOT_ORDERS = size_t{1} << 20;
+
+// Flow variants: production-like default, then one knob turned at a time.
+struct FlowVariant {
+    const char* name;
+    FlowConfig  cfg;
+};
+
+static std::vector<FlowVariant> flow_variants()
+{
+    FlowConfig base;
+    FlowConfig heavy_cancel = base;  heavy_cancel.cancel_ratio = 0.48;
+                                     heavy_cancel.market_ratio = 0.005;
+    FlowConfig wide = base;          wide.alpha = 0.7;
+    FlowConfig bursty = base;        bursty.burst_mean = 16;
+    return {{"flow_default", base}, {"flow_heavy_cancel", heavy_cancel},
+            {"flow_wide", wide}, {"flow_bursty", bursty}};
+}
+
+template <typename Levels>
+static void register_backend(std::vector<MicroBenchmark>& out, const char* backend)
+{
+    out.push_back({"add", backend, 0, bm_add<Levels>});
+
+    for (size_t depth : CANCEL_DEPTHS) {
+        long d = static_cast<long>(depth);
+        out.push_back({"cancel_front", backend, d,
+                       [depth](size_t n) { return bm_cancel<Levels>(n, depth, CancelAt::FRONT); }});
+        out.push_back({"cancel_middle", backend, d,
+                       [depth](size_t n) { return bm_cancel<Levels>(n, depth, CancelAt::MIDDLE); }});
+        out.push_back({"cancel_back", backend, d,
+                       [depth](size_t n) { return bm_cancel<Levels>(n, depth, CancelAt::BACK); }});
+    }
+
+    for (size_t levels : SWEEP_LEVELS)
+        out.push_back({"market_sweep", backend, static_cast<long>(levels),
+                       [levels](size_t n) { return bm_market_sweep<Levels>(n, levels); }});
+
+    out.push_back({"top_of_book_mutex", backend, 0, bm_top_of_book<MutexPolicy, Levels>});
+    out.push_back({"top_of_book_seqlock", backend, 0, bm_top_of_book<SeqLockPolicy, Levels>});
+
+    long snap = static_cast<long>(SNAPSHOT_ORDERS);
+    out.push_back({"snapshot_load", backend, snap,
+                   [](size_t n) { return bm_rebuild<Levels>(n, SNAPSHOT_ORDERS, Rebuild::LOAD); }});
+    out.push_back({"snapshot_replay", backend, snap,
+                   [](size_t n) { return bm_rebuild<Levels>(n, SNAPSHOT_ORDERS, Rebuild::REPLAY); }});
+    out.push_back({"snapshot_take", backend, snap,
+                   [](size_t n) { return bm_rebuild<Levels>(n, SNAPSHOT_ORDERS, Rebuild::SNAPSHOT); }});
+
+    for (const auto& v : flow_variants()) {
+        FlowConfig cfg = v.cfg;
+        out.push_back({v.name, backend, 0, [cfg](size_t n) { return bm_flow<Levels>(n, cfg); }});
+    }
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string dump_path;
+    size_t dump_count = 1'000'000;
+    FlowConfig dump_cfg;
+    uint32_t dump_symbols = 1;
+    double dump_skew = 1.0;
+
+    auto usage = [&] {
+        std::cerr << "usage: " << argv[0] << " [--filter SUBSTR] [--counters]\n"
+                  << "       " << argv[0] << " --dump FILE [--count N] [--cancel-ratio X]"
+                     " [--market-ratio X] [--alpha A] [--burst B] [--seed S]"
+                     " [--symbols N [--skew Z]]\n";
+        return 1;
+    };
+    bool counters = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--counters") {
+            counters = true;
+            continue;
+        }
+        if (i + 1 >= argc) return usage();
+        std::string val = argv[++i];
+        if      (arg == "--filter")       filter = val;
+        else if (arg == "--dump")         dump_path = val;
+        else if (arg == "--count")        dump_count = std::stoull(val);
+        else if (arg == "--cancel-ratio") dump_cfg.cancel_ratio = std::stod(val);
+        else if (arg == "--market-ratio") dump_cfg.market_ratio = std::stod(val);
+        else if (arg == "--alpha")        dump_cfg.alpha = std::stod(val);
+        else if (arg == "--burst")        dump_cfg.burst_mean = std::stod(val);
+        else if (arg == "--seed")         dump_cfg.seed = std::stoull(val);
+        else if (arg == "--symbols")      dump_symbols = static_cast<uint32_t>(std::stoul(val));
+        else if (arg == "--skew")         dump_skew = std::stod(val);
+        else return usage();
+    }
+
+    // --dump: write a generated flow in the journal format and exit
+    // (--symbols > 1: Zipf-skewed multi-symbol flow, for replay_symbols)
+    if (!dump_path.empty()) {
+        if (dump_symbols > 1)
+            write_flow(dump_path, MultiSymbolFlow(dump_cfg, dump_symbols, dump_skew).generate(dump_count));
+        else
+            write_flow(dump_path, FlowGenerator(dump_cfg).generate(dump_count));
+        std::cout << "Wrote " << dump_count << " commands";
+        if (dump_symbols > 1)
+            std::cout << " over " << dump_symbols << " symbols (skew " << dump_skew << ")";
+        std::cout << " → " << dump_path << "\n";
+        return 0;
+    }
+
+    std::vector<MicroBenchmark> benchmarks;
+    register_backend<MapLevels>(benchmarks, "MapLevels");
+    register_backend<TickLadder>(benchmarks, "TickLadder");
+    register_index<StdIndex>(benchmarks, "unordered_map");
+    register_index<OrderIndex>(benchmarks, "OrderIndex");
+    register_level_scans(benchmarks);
+
+    std::cout << "========================================\n"
+              << "Microbenchmarks (median of " << REPETITIONS << ")\n"
+              << "========================================\n\n";
+    if (counters) {
+        g_counters = std::make_unique<PerfCounters>();
+        if (!g_counters->available()) {
+            std::cout << "(hardware counters unavailable here: times only)\n\n";
+            g_counters.reset();
+        }
+    }
+
+    std::vector<MicroResult> results;
+    for (const auto& b : benchmarks) {
+        std::string full = b.name + "/" + b.backend + "/" + std::to_string(b.arg);
+        if (!filter.empty() && full.find(filter) == std::string::npos)
+            continue;
+        MicroResult r = run_benchmark(b);
+        std::cout << "  " << full
+                  << " | iters=" << r.iterations
+                  << " | " << r.ns_per_op << " ns/op"
+                  << " | " << static_cast<long>(r.ops_per_sec) << " ops/s";
+        if (g_counters)
+            std::cout << std::fixed << std::setprecision(1)
+                      << " | " << r.insns_per_op << " insn/op"
+                      << " | " << r.branches_per_op << " br/op"
+                      << " | " << r.misses_per_op << " miss/op"
+                      << std::defaultfloat << std::setprecision(6);
+        std::cout << "\n";
+        results.push_back(r);
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/micro_results.csv");
+    csv << "benchmark,backend,arg,iterations,ns_per_op,ops_per_sec,"
+           "insns_per_op,cycles_per_op,branches_per_op,branch_misses_per_op\n";
+    for (const auto& r : results) {
+        csv << r.name        << ","
+            << r.backend     << ","
+            << r.arg         << ","
+            << r.iterations  << ","
+            << r.ns_per_op   << ","
+            << static_cast<long>(r.ops_per_sec) << ","
+            << r.insns_per_op    << ","
+            << r.cycles_per_op   << ","
+            << r.branches_per_op << ","
+            << r.misses_per_op   << "\n";
+    }
+
+    std::cout << "\nResults saved → results/micro_results.csv\n";
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include "order_book.h"
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <filesystem>
+
+// ── Layouts under test ────────────────────────────────────────────────────────
+// WideNode is the resting-order node before the hot/cold split: a full Order
+// plus three pointers. The packed layout is the book's OrderNode (hot, read
+// by the match loop) with its OrderCold kept in a separate array.
+struct WideNode {
+    Order       order;
+    WideNode*   prev;
+    WideNode*   next;
+    PriceLevel* level;
+};
+
+static constexpr size_t ORDER_COUNTS[] = {1 << 14, 1 << 20};
+static constexpr int    REPEATS        = 5;
+
+// ── Result record ─────────────────────────────────────────────────────────────
+struct LayoutResult {
+    std::string layout;
+    std::string pattern;
+    size_t      orders;
+    size_t      bytes_per_order;       // all storage per resting order
+    size_t      hot_bytes_per_order;   // what the match loop touches
+    double      ns_per_order;
+};
+
+// Node order along the FIFO: allocation order, or shuffled the way a free
+// list hands out slots after heavy cancel traffic.
+static std::vector<size_t> link_order(size_t n, bool shuffled)
+{
+    std::vector<size_t> idx(n);
+    std::iota(idx.begin(), idx.end(), size_t{0});
+    if (shuffled)
+        std::shuffle(idx.begin(), idx.end(), std::mt19937_64(42));
+    return idx;
+}
+
+template <typename Node>
+static void link(std::vector<Node>& nodes, const std::vector<size_t>& order)
+{
+    for (size_t i = 0; i < order.size(); ++i) {
+        Node& n = nodes[order[i]];
+        n.prev = i > 0 ? &nodes[order[i - 1]] : nullptr;
+        n.next = i + 1 < order.size() ? &nodes[order[i + 1]] : nullptr;
+    }
+}
+
+// Same loads per order as the match loop: next, remaining, id.
+template <typename Node, typename Remaining, typename Id>
+static double scan_ns_per_order(const Node* head, size_t n, Remaining remaining, Id id)
+{
+    double best = 1e30;
+    for (int r = 0; r < REPEATS; ++r) {
+        uint64_t qty = 0, ids = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (const Node* p = head; p; p = p->next) {
+            qty += remaining(p);
+            ids ^= id(p);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        asm volatile("" : : "r"(qty), "r"(ids));
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+    return best / static_cast<double>(n);
+}
+
+static LayoutResult run_wide(size_t n, bool shuffled)
+{
+    std::vector<WideNode> nodes(n);
+    for (size_t i = 0; i < n; ++i)
+        nodes[i].order = Order::Limit(i + 1, 1, Side::SELL, 100, 10);
+    auto order = link_order(n, shuffled);
+    link(nodes, order);
+
+    double ns = scan_ns_per_order(&nodes[order[0]], n,
+                                  [](const WideNode* p) { return p->order.remaining; },
+                                  [](const WideNode* p) { return p->order.id; });
+    return {"wide", shuffled ? "recycled" : "fifo", n, sizeof(WideNode), sizeof(WideNode), ns};
+}
+
+static LayoutResult run_packed(size_t n, bool shuffled)
+{
+    std::vector<OrderNode> nodes(n);
+    std::vector<OrderCold> cold(n);
+    for (size_t i = 0; i < n; ++i) {
+        nodes[i].id = i + 1;
+        nodes[i].remaining = 10;
+        nodes[i].slot = static_cast<uint32_t>(i);
+        cold[i] = OrderCold{100, nullptr, 1, 0, 0, 1};
+    }
+    auto order = link_order(n, shuffled);
+    link(nodes, order);
+
+    double ns = scan_ns_per_order(&nodes[order[0]], n,
+                                  [](const OrderNode* p) { return uint64_t{p->remaining}; },
+                                  [](const OrderNode* p) { return p->id; });
+    return {"packed", shuffled ? "recycled" : "fifo", n,
+            sizeof(OrderNode) + sizeof(OrderCold), sizeof(OrderNode), ns};
+}
+
+// End to end: one market order sweeping n resting orders over 64 levels.
+static LayoutResult run_book_sweep(size_t n)
+{
+    double best = 1e30;
+    for (int r = 0; r < REPEATS; ++r) {
+        OrderBook<NullLockPolicy, TickLadder> book;
+        for (size_t i = 0; i < n; ++i)
+            book.add_order(Order::Limit(i + 1, 1, Side::SELL, 100 + i % 64, 10));
+
+        auto t0 = std::chrono::steady_clock::now();
+        book.add_order(Order::Market(n + 1, 1, Side::BUY, n * 10));
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+    return {"packed", "book_sweep", n, sizeof(OrderNode) + sizeof(OrderCold),
+            sizeof(OrderNode), best / static_cast<double>(n)};
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main()
+{
+    std::cout << "========================================\n"
+              << "Resting-order layout: wide (" << sizeof(WideNode) << " B) vs packed ("
+              << sizeof(OrderNode) << " B hot + " << sizeof(OrderCold) << " B cold)\n"
+              << "========================================\n\n";
+
+    std::vector<LayoutResult> results;
+    for (size_t n : ORDER_COUNTS) {
+        for (bool shuffled : {false, true}) {
+            results.push_back(run_wide(n, shuffled));
+            results.push_back(run_packed(n, shuffled));
+        }
+        results.push_back(run_book_sweep(n));
+    }
+
+    for (const auto& r : results) {
+        std::cout << "  [" << r.layout << " / " << r.pattern << "]"
+                  << " orders=" << r.orders
+                  << " | bytes/order=" << r.bytes_per_order
+                  << " (hot " << r.hot_bytes_per_order << ")"
+                  << " | scan=" << r.ns_per_order << " ns/order\n";
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/order_layout_results.csv");
+    csv << "layout,pattern,orders,bytes_per_order,hot_bytes_per_order,ns_per_order\n";
+    for (const auto& r : results) {
+        csv << r.layout          << ","
+            << r.pattern         << ","
+            << r.orders          << ","
+            << r.bytes_per_order << ","
+            << r.hot_bytes_per_order << ","
+            << r.ns_per_order    << "\n";
+    }
+
+    std::cout << "\nResults saved → results/order_layout_results.csv\n";
+    return 0;
+}
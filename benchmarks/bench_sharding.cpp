@@ -0,0 +1,167 @@
+#include "matching_engine.h"
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <filesystem>
+
+// ── Configuration ─────────────────────────────────────────────────────────────
+static constexpr int      SHARD_COUNTS[]     = {1, 2, 4, 8};
+static constexpr int      NUM_PRODUCERS      = 2;
+static constexpr uint32_t NUM_SYMBOLS        = 64;
+static constexpr int      OPS_PER_PRODUCER   = 200'000;
+static constexpr int      CANCEL_PCT         = 25;
+
+// ── Pre-generated command stream ──────────────────────────────────────────────
+// Generated up front so RNG cost stays out of the timed region. Ids are
+// disjoint per producer; cancels target the producer's own earlier adds.
+static std::vector<EngineCommand> make_stream(int producer)
+{
+    std::mt19937 rng(static_cast<uint32_t>(producer) * 7654321u + 42u);
+    std::uniform_int_distribution<uint32_t> sym_dist(0, NUM_SYMBOLS - 1);
+    std::uniform_int_distribution<uint64_t> price_dist(9950, 10050);
+    std::uniform_int_distribution<uint64_t> qty_dist(1, 100);
+    std::uniform_int_distribution<int>      side_dist(0, 1);
+    std::uniform_int_distribution<int>      op_dist(0, 99);
+
+    std::vector<EngineCommand> cmds;
+    std::vector<std::pair<uint32_t, uint64_t>> live;
+    cmds.reserve(OPS_PER_PRODUCER);
+
+    uint64_t next_id = static_cast<uint64_t>(producer) << 40;
+    for (int i = 0; i < OPS_PER_PRODUCER; ++i) {
+        if (op_dist(rng) < CANCEL_PCT && !live.empty()) {
+            size_t k = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+            auto [sym, id] = live[k];
+            live[k] = live.back();
+            live.pop_back();
+            cmds.push_back({EngineCommand::Kind::CANCEL, sym, id, Order{}});
+        } else {
+            uint32_t sym  = sym_dist(rng);
+            Side     side = side_dist(rng) == 0 ? Side::BUY : Side::SELL;
+            Order o = Order::Limit(++next_id, sym, side, price_dist(rng), qty_dist(rng));
+            live.emplace_back(sym, o.id);
+            cmds.push_back({EngineCommand::Kind::ADD, sym, o.id, o});
+        }
+    }
+    return cmds;
+}
+
+// ── Result record ─────────────────────────────────────────────────────────────
+struct ShardResult {
+    std::string mode;
+    int         shards;
+    uint64_t    total_ops;
+    long        throughput_ops_per_sec;
+};
+
+// ── Sharded engine: producers → SPSC → single-writer shards ──────────────────
+static ShardResult run_engine(int num_shards,
+                              const std::vector<std::vector<EngineCommand>>& streams)
+{
+    EngineConfig cfg;
+    cfg.num_shards    = num_shards;
+    cfg.num_producers = NUM_PRODUCERS;
+    cfg.placement     = Placement::COMPACT;
+    MatchingEngine<TickLadder> engine(cfg);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (const auto& c : streams[p]) {
+                if (c.kind == EngineCommand::Kind::ADD)
+                    engine.add_order(p, c.order);
+                else
+                    engine.cancel_order(p, c.symbol_id, c.order_id);
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    engine.flush();
+
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    uint64_t ops = static_cast<uint64_t>(NUM_PRODUCERS) * OPS_PER_PRODUCER;
+    return {"engine", num_shards, ops, static_cast<long>(ops / elapsed)};
+}
+
+// ── Baseline: same producers calling one mutex-guarded book per symbol ──────
+static ShardResult run_locked(const std::vector<std::vector<EngineCommand>>& streams)
+{
+    using Book = OrderBook<MutexPolicy, TickLadder>;
+    std::vector<std::unique_ptr<Book>> books;
+    for (uint32_t s = 0; s < NUM_SYMBOLS; ++s)
+        books.push_back(std::make_unique<Book>());
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            for (const auto& c : streams[p]) {
+                if (c.kind == EngineCommand::Kind::ADD)
+                    books[c.symbol_id]->add_order(c.order);
+                else
+                    books[c.symbol_id]->cancel_order(c.order_id);
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    uint64_t ops = static_cast<uint64_t>(NUM_PRODUCERS) * OPS_PER_PRODUCER;
+    return {"locked_per_symbol", 0, ops, static_cast<long>(ops / elapsed)};
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main()
+{
+    std::cout << "========================================\n"
+              << "Sharding Benchmark: MatchingEngine vs locked books\n"
+              << "producers=" << NUM_PRODUCERS
+              << " symbols=" << NUM_SYMBOLS
+              << " ops_per_producer=" << OPS_PER_PRODUCER
+              << " cancel=" << CANCEL_PCT << "%\n"
+              << "hardware_concurrency=" << std::thread::hardware_concurrency() << "\n"
+              << "========================================\n\n";
+
+    std::vector<std::vector<EngineCommand>> streams;
+    for (int p = 0; p < NUM_PRODUCERS; ++p)
+        streams.push_back(make_stream(p));
+
+    std::vector<ShardResult> results;
+    results.push_back(run_locked(streams));
+    for (int shards : SHARD_COUNTS)
+        results.push_back(run_engine(shards, streams));
+
+    for (const auto& r : results) {
+        std::cout << "  [" << r.mode << "]"
+                  << " shards=" << r.shards
+                  << " | ops="  << r.total_ops
+                  << " | tput=" << r.throughput_ops_per_sec << " ops/s\n";
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/sharding_results.csv");
+    csv << "mode,shards,producers,symbols,total_ops,throughput_ops_per_sec\n";
+    for (const auto& r : results) {
+        csv << r.mode      << ","
+            << r.shards    << ","
+            << NUM_PRODUCERS << ","
+            << NUM_SYMBOLS << ","
+            << r.total_ops << ","
+            << r.throughput_ops_per_sec << "\n";
+    }
+
+    std::cout << "\nResults saved → results/sharding_results.csv\n";
+    return 0;
+}
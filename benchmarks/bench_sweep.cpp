@@ -0,0 +1,117 @@
+#include "order_book.h"
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+// ── Configuration ─────────────────────────────────────────────────────────────
+static constexpr size_t SWEEP_LEVELS[]   = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+static constexpr int    ORDERS_PER_LEVEL = 4;
+static constexpr size_t ORDERS_PER_RUN   = 4'000'000;   // resting orders swept per configuration
+static constexpr size_t MIN_SWEEPS       = 200;
+static constexpr size_t MAX_SWEEPS       = 20'000;
+
+using Clock = std::chrono::steady_clock;
+
+// ── Result record ─────────────────────────────────────────────────────────────
+struct RunResult {
+    std::string backend;
+    std::string side;
+    size_t      levels;
+    size_t      sweeps;
+    long        p50_ns;
+    long        p99_ns;
+    long        p999_ns;
+    long        max_ns;
+    double      ns_per_level;   // p50 / levels
+};
+
+// One market order taking `levels` whole levels of ORDERS_PER_LEVEL orders
+// each, from the best price outwards. The book is refilled between sweeps
+// (untimed); each sweep is timed on its own so the tail is visible.
+// `taker` BUY sweeps asks upwards, SELL sweeps bids downwards.
+template <typename Levels>
+static RunResult run_sweep(const char* backend, Side taker, size_t levels)
+{
+    OrderBook<MutexPolicy, Levels> book;
+    book.reserve(levels * ORDERS_PER_LEVEL, levels);
+    ExecutionRing fills(levels * ORDERS_PER_LEVEL + 16);
+
+    Side maker = taker == Side::BUY ? Side::SELL : Side::BUY;
+    size_t sweeps = std::clamp(ORDERS_PER_RUN / (levels * ORDERS_PER_LEVEL), MIN_SWEEPS, MAX_SWEEPS);
+    std::vector<double> lats;
+    lats.reserve(sweeps);
+
+    uint64_t id = 1;
+    for (size_t s = 0; s < sweeps; ++s) {
+        for (size_t l = 0; l < levels; ++l) {
+            uint64_t price = maker == Side::SELL ? 10001 + l : 9999 - l;
+            for (int k = 0; k < ORDERS_PER_LEVEL; ++k)
+                book.add_order(Order::Limit(id++, 1, maker, price, 10));
+        }
+        Order sweep = Order::Market(id++, 1, taker, levels * ORDERS_PER_LEVEL * 10);
+        auto t0 = Clock::now();
+        book.add_order(sweep, &fills);
+        lats.push_back(std::chrono::duration<double, std::nano>(Clock::now() - t0).count());
+        fills.clear();
+    }
+
+    std::sort(lats.begin(), lats.end());
+    auto pct = [&](double q) {
+        return static_cast<long>(lats[std::min(lats.size() - 1, static_cast<size_t>(q * lats.size()))]);
+    };
+    long p50 = pct(0.50);
+    return {backend, taker == Side::BUY ? "buy" : "sell", levels, sweeps,
+            p50, pct(0.99), pct(0.999), static_cast<long>(lats.back()),
+            static_cast<double>(p50) / static_cast<double>(levels)};
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main()
+{
+    std::cout << "========================================\n"
+              << "Market sweep latency vs levels taken (MutexPolicy, "
+              << ORDERS_PER_LEVEL << " orders per level)\n"
+              << "========================================\n\n";
+
+    std::vector<RunResult> results;
+    auto print = [](const RunResult& r) {
+        std::cout << "  [" << r.backend << "] " << r.side << " levels=" << r.levels
+                  << " | p50="  << r.p50_ns << " ns"
+                  << " | p99="  << r.p99_ns << " ns"
+                  << " | p99.9=" << r.p999_ns << " ns"
+                  << " | max="  << r.max_ns << " ns"
+                  << " | " << r.ns_per_level << " ns/level\n";
+    };
+
+    for (Side taker : {Side::BUY, Side::SELL}) {
+        for (size_t levels : SWEEP_LEVELS) {
+            results.push_back(run_sweep<MapLevels>("MapLevels", taker, levels));
+            print(results.back());
+            results.push_back(run_sweep<TickLadder>("TickLadder", taker, levels));
+            print(results.back());
+        }
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/sweep_results.csv");
+    csv << "backend,side,levels,sweeps,p50_ns,p99_ns,p999_ns,max_ns,ns_per_level\n";
+    for (const auto& r : results) {
+        csv << r.backend      << ","
+            << r.side         << ","
+            << r.levels       << ","
+            << r.sweeps       << ","
+            << r.p50_ns       << ","
+            << r.p99_ns       << ","
+            << r.p999_ns      << ","
+            << r.max_ns       << ","
+            << r.ns_per_level << "\n";
+    }
+
+    std::cout << "\nResults saved → results/sweep_results.csv\n";
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "book_views.h"
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <filesystem>
+
+// ── Configuration ─────────────────────────────────────────────────────────────
+static constexpr int    READER_COUNTS[]  = {0, 1, 2, 4};
+static constexpr int    RESTING_ORDERS   = 20'000;   // preloaded, and roughly kept
+static constexpr int    WRITER_OPS       = 200'000;
+static constexpr double RUN_SECONDS      = 2.0;      // cap per run: starved writers finish few ops
+static constexpr int    PUBLISH_EVERY    = 256;      // writes between view publishes
+static constexpr uint64_t MID            = 10'000;
+static constexpr uint64_t SPREAD_TICKS   = 1'000;    // each side spans this many prices
+
+using Book  = OrderBook<SharedMutexPolicy, TickLadder>;
+using Views = BookViews<SharedMutexPolicy, TickLadder>;
+using Clock = std::chrono::steady_clock;
+
+// ── Pre-generated command stream ──────────────────────────────────────────────
+// Non-crossing adds and cancels of earlier adds, half and half, so the book
+// stays near RESTING_ORDERS orders and no write trades.
+static std::vector<BookCommand> make_stream(std::vector<Order>& preload)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint64_t> tick_dist(1, SPREAD_TICKS);
+    std::uniform_int_distribution<uint64_t> qty_dist(1, 100);
+    std::uniform_int_distribution<int>      coin(0, 1);
+
+    uint64_t next_id = 0;
+    std::vector<uint64_t> live;
+    auto make_order = [&] {
+        Side side = coin(rng) ? Side::BUY : Side::SELL;
+        uint64_t price = side == Side::BUY ? MID - tick_dist(rng) : MID + tick_dist(rng);
+        live.push_back(++next_id);
+        return Order::Limit(next_id, 1, side, price, qty_dist(rng));
+    };
+
+    for (int i = 0; i < RESTING_ORDERS; ++i)
+        preload.push_back(make_order());
+
+    std::vector<BookCommand> cmds;
+    cmds.reserve(WRITER_OPS);
+    for (int i = 0; i < WRITER_OPS; ++i) {
+        if (coin(rng) && !live.empty()) {
+            size_t k = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+            cmds.push_back(BookCommand::Cancel(live[k]));
+            live[k] = live.back();
+            live.pop_back();
+        } else {
+            cmds.push_back(BookCommand::Add(make_order()));
+        }
+    }
+    return cmds;
+}
+
+// One heavy read: VWAP of a large order on each side, quantity within 100
+// ticks of the touch, and a walk of every resting order (a risk pass over
+// the hidden reserve). Returns something derived from all of it.
+static double heavy_read(const BookView& v)
+{
+    double r = v.vwap(Side::BUY, 50'000) + v.vwap(Side::SELL, 50'000);
+    r += static_cast<double>(v.quantity_through(Side::BUY, MID - 100)
+                             + v.quantity_through(Side::SELL, MID + 100));
+    uint64_t reserve = 0;
+    for (const ViewOrder& o : v.orders)
+        reserve += o.visible + o.reserve;
+    return r + static_cast<double>(reserve);
+}
+
+// ── Result record ─────────────────────────────────────────────────────────────
+struct RunResult {
+    std::string mode;
+    int         readers;
+    size_t      writes;         // completed within RUN_SECONDS
+    long        p50_ns;
+    long        p99_ns;
+    long        p999_ns;
+    long        max_ns;
+    size_t      publishes;
+    long        publish_p50_ns;
+    long        publish_p99_ns;
+    uint64_t    reader_queries;
+};
+
+static long pct(const std::vector<double>& sorted, double q)
+{
+    if (sorted.empty()) return 0;
+    return static_cast<long>(sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()))]);
+}
+
+// "views": readers pin the current BookView and read it lock-free; the
+// writer publishes one every PUBLISH_EVERY writes.
+// "locked": readers copy the book with OrderBook::view() under its read
+// lock each time (what a reader does without views) and read the copy.
+static RunResult run(bool use_views, int readers, const std::vector<Order>& preload,
+                     const std::vector<BookCommand>& cmds)
+{
+    Book book;
+    book.reserve(RESTING_ORDERS * 2, SPREAD_TICKS * 2 + 1);
+    for (const Order& o : preload)
+        book.add_order(o);
+
+    ViewConfig cfg;
+    cfg.max_readers = static_cast<size_t>(std::max(readers, 1));
+    Views views(book, cfg);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int>  ready{0};
+    std::vector<uint64_t> queries(static_cast<size_t>(readers), 0);
+    std::vector<double> sink(static_cast<size_t>(readers), 0);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            BookView local;
+            ready.fetch_add(1);
+            uint64_t n = 0;
+            double acc = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (use_views) {
+                    auto v = views.read(static_cast<size_t>(r));
+                    acc += heavy_read(*v);
+                } else {
+                    book.view(local);
+                    acc += heavy_read(local);
+                }
+                ++n;
+            }
+            queries[static_cast<size_t>(r)] = n;
+            sink[static_cast<size_t>(r)] = acc;
+        });
+    }
+    while (ready.load() < readers)
+        std::this_thread::yield();
+
+    std::vector<double> lats, pubs;
+    lats.reserve(cmds.size());
+    pubs.reserve(cmds.size() / PUBLISH_EVERY + 1);
+    auto deadline = Clock::now() + std::chrono::duration<double>(RUN_SECONDS);
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        const BookCommand& c = cmds[i];
+        auto t0 = Clock::now();
+        if (c.kind == BookCommand::Kind::ADD)
+            book.add_order(c.order);
+        else
+            book.cancel_order(c.order.id);
+        auto t1 = Clock::now();
+        lats.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+        if (t1 > deadline) break;
+        if (use_views && (i + 1) % PUBLISH_EVERY == 0) {
+            views.publish();
+            pubs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - t1).count());
+        }
+    }
+    stop.store(true);
+    for (auto& t : threads) t.join();
+
+    std::sort(lats.begin(), lats.end());
+    std::sort(pubs.begin(), pubs.end());
+    uint64_t total_queries = 0;
+    for (uint64_t q : queries) total_queries += q;
+    return {use_views ? "views" : "locked", readers, lats.size(),
+            pct(lats, 0.50), pct(lats, 0.99), pct(lats, 0.999), static_cast<long>(lats.back()),
+            pubs.size(), pct(pubs, 0.50), pct(pubs, 0.99), total_queries};
+}
+
+// ── Main ──────────────────────────────────────────────────────────────────────
+int main()
+{
+    std::cout << "========================================\n"
+              << "Writer latency under heavy readers (SharedMutexPolicy, TickLadder, "
+              << RESTING_ORDERS << " resting orders)\n"
+              << "========================================\n\n";
+
+    std::vector<Order> preload;
+    std::vector<BookCommand> cmds = make_stream(preload);
+
+    std::vector<RunResult> results;
+    for (int readers : READER_COUNTS) {
+        for (bool use_views : {false, true}) {
+            if (readers == 0 && !use_views) continue;   // same as views with no readers, minus publishes
+            results.push_back(run(use_views, readers, preload, cmds));
+            const RunResult& r = results.back();
+            std::cout << "  [" << r.mode << "] readers=" << r.readers
+                      << " | writes=" << r.writes
+                      << " | write p50="  << r.p50_ns << " ns"
+                      << " | p99="   << r.p99_ns << " ns"
+                      << " | p99.9=" << r.p999_ns << " ns"
+                      << " | max="   << r.max_ns << " ns"
+                      << " | publish p50=" << r.publish_p50_ns << " ns"
+                      << " p99=" << r.publish_p99_ns << " ns"
+                      << " | reads=" << r.reader_queries << std::endl;
+        }
+    }
+
+    // ── CSV output ────────────────────────────────────────────────────────────
+    std::filesystem::create_directories("results");
+    std::ofstream csv("results/views_results.csv");
+    csv << "mode,readers,writes,p50_ns,p99_ns,p999_ns,max_ns,publishes,publish_p50_ns,publish_p99_ns,reader_queries\n";
+    for (const auto& r : results) {
+        csv << r.mode           << ","
+            << r.readers        << ","
+            << r.writes         << ","
+            << r.p50_ns         << ","
+            << r.p99_ns         << ","
+            << r.p999_ns        << ","
+            << r.max_ns         << ","
+            << r.publishes      << ","
+            << r.publish_p50_ns << ","
+            << r.publish_p99_ns << ","
+            << r.reader_queries << "\n";
+    }
+
+    std::cout << "\nResults saved → results/views_results.csv\n";
+    return 0;
+}
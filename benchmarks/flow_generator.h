@@ -0,0 +1,157 @@
+#pragma once
+#include "journal.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// ── Order-flow generator ──────────────────────────────────────────────────────
+// Deterministic (seeded) command stream shaped like production flow rather
+// than uniform-random adds:
+//   - most orders are cancelled again (cancel_ratio of commands are cancels
+//     of a random live order)
+//   - limit prices sit a power-law distance from a drifting mid, so depth
+//     clusters near the touch with a thin tail; a small distance on either
+//     side of a moving mid crosses now and then
+//   - a small share of market orders sweeps the touch
+//   - orders arrive in bursts at one side and price (geometric burst length)
+// Commands come out as JournalRecords, so a stream can be dumped with
+// write_flow() and replayed by replay_journal or bench_comparison --journal.
+struct FlowConfig {
+    uint64_t seed          = 42;
+    double   cancel_ratio  = 0.45;   // share of commands that cancel a live order
+    double   market_ratio  = 0.02;   // share of commands that are market orders
+    double   alpha         = 1.5;    // power-law exponent of distance from mid
+    uint32_t max_distance  = 200;    // ticks; longer tails are clipped
+    double   burst_mean    = 1.0;    // mean orders per burst (1 = no bursts)
+    double   mid_step_prob = 0.01;   // chance per add that mid moves one tick
+    uint64_t mid           = 10000;
+    uint64_t max_qty       = 100;
+    uint32_t symbol        = 1;
+};
+
+class FlowGenerator {
+public:
+    explicit FlowGenerator(const FlowConfig& cfg) : cfg_(cfg), rng_(cfg.seed), mid_(cfg.mid) {}
+
+    JournalRecord next() {
+        double u = unit_(rng_);
+        if (u < cfg_.cancel_ratio && !live_.empty())
+            return cancel_one();
+        if (u < cfg_.cancel_ratio + cfg_.market_ratio) {
+            Side side = coin_(rng_) ? Side::BUY : Side::SELL;
+            return make_add_record(Order::Market(next_id_++, cfg_.symbol, side, qty()));
+        }
+        return add_one();
+    }
+
+    std::vector<JournalRecord> generate(size_t n) {
+        std::vector<JournalRecord> out;
+        out.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            out.push_back(next());
+        return out;
+    }
+
+private:
+    JournalRecord cancel_one() {
+        size_t k = std::uniform_int_distribution<size_t>(0, live_.size() - 1)(rng_);
+        uint64_t id = live_[k];
+        live_[k] = live_.back();
+        live_.pop_back();
+        return make_cancel_record(cfg_.symbol, id);
+    }
+
+    JournalRecord add_one() {
+        if (burst_left_ == 0) {
+            if (unit_(rng_) < cfg_.mid_step_prob)
+                mid_ += coin_(rng_) ? 1 : -1;
+            burst_side_  = coin_(rng_) ? Side::BUY : Side::SELL;
+            uint64_t d   = distance();
+            burst_price_ = burst_side_ == Side::BUY ? mid_ - d : mid_ + d;
+            burst_left_  = burst_length();
+        }
+        --burst_left_;
+
+        uint64_t id = next_id_++;
+        live_.push_back(id);
+        return make_add_record(Order::Limit(id, cfg_.symbol, burst_side_, burst_price_, qty()));
+    }
+
+    // Inverse-CDF Pareto sample minus one: 0 is most likely, P(d >= x) ~ x^-alpha
+    uint64_t distance() {
+        double x = std::pow(1.0 - unit_(rng_), -1.0 / cfg_.alpha) - 1.0;
+        return x >= cfg_.max_distance ? cfg_.max_distance : static_cast<uint64_t>(x);
+    }
+
+    uint32_t burst_length() {
+        if (cfg_.burst_mean <= 1.0) return 1;
+        return 1 + std::geometric_distribution<uint32_t>(1.0 / cfg_.burst_mean)(rng_);
+    }
+
+    uint64_t qty() { return std::uniform_int_distribution<uint64_t>(1, cfg_.max_qty)(rng_); }
+
+    FlowConfig cfg_;
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> unit_{0.0, 1.0};
+    std::bernoulli_distribution coin_{0.5};
+
+    uint64_t mid_;
+    uint64_t next_id_ = 1;
+    std::vector<uint64_t> live_;   // ids added and not yet cancelled
+
+    Side     burst_side_  = Side::BUY;
+    uint64_t burst_price_ = 0;
+    uint32_t burst_left_  = 0;
+};
+
+// Many symbols at once, for backtests: one FlowGenerator per symbol
+// (symbols 1..symbols, each seeded from cfg.seed and its id), interleaved by
+// drawing each command's symbol from a Zipf(skew) distribution. Rank k gets
+// weight 1/k^skew, so at skew ≈ 1 a handful of symbols carry most of the
+// traffic, as in a real universe. Order ids are unique per symbol only.
+class MultiSymbolFlow {
+public:
+    MultiSymbolFlow(const FlowConfig& cfg, uint32_t symbols, double skew) : rng_(cfg.seed) {
+        double total = 0;
+        for (uint32_t k = 1; k <= symbols; ++k) {
+            FlowConfig c = cfg;
+            c.symbol = k;
+            c.seed = cfg.seed * 1000003 + k;
+            flows_.emplace_back(c);
+            total += 1.0 / std::pow(static_cast<double>(k), skew);
+            cdf_.push_back(total);
+        }
+        for (double& x : cdf_) x /= total;
+    }
+
+    JournalRecord next() {
+        double u = unit_(rng_);
+        size_t k = std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin();
+        return flows_[k < flows_.size() ? k : flows_.size() - 1].next();
+    }
+
+    std::vector<JournalRecord> generate(size_t n) {
+        std::vector<JournalRecord> out;
+        out.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            out.push_back(next());
+        return out;
+    }
+
+private:
+    std::vector<FlowGenerator> flows_;
+    std::vector<double> cdf_;
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> unit_{0.0, 1.0};
+};
+
+// Write a generated stream in the journal format.
+inline void write_flow(const std::string& path, const std::vector<JournalRecord>& flow) {
+    JournalWriter w(path);
+    for (const JournalRecord& r : flow)
+        w.append(r);
+    w.flush();
+}
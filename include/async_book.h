@@ -0,0 +1,104 @@
+#pragma once
+#include "order_book.h"
+#include "spin_lock.h"
+#include "spsc_queue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Completion of one AsyncBook request. The caller owns it and must keep it
+// alive, and not submit it again, until ready(). A client pipelines by
+// holding several of these at once.
+class AsyncOp {
+public:
+    bool ready() const { return done_.load(std::memory_order_acquire); }
+
+    // Spin, then yield, until the drain thread completes the request.
+    const BookResult& wait() const {
+        SpinBackoff backoff;
+        while (!ready())
+            backoff.pause();
+        return result_;
+    }
+
+    const BookResult& result() const { return result_; }   // once ready()
+
+private:
+    template <typename, typename> friend class AsyncBook;
+
+    BookResult result_;
+    std::atomic<bool> done_{false};
+};
+
+struct AsyncConfig {
+    size_t num_clients    = 1;
+    size_t queue_capacity = 1024;   // per client: its most requests in flight
+    size_t max_batch      = 64;     // commands per apply_batch() call
+    int    cpu            = -1;     // pin the drain thread (-1 = don't)
+    size_t idle_spins     = 4096;   // empty polls (with yield) before the drain thread sleeps
+};
+
+// Asynchronous front-end for an OrderBook. Client threads enqueue commands
+// and go back to their own work; one drain thread applies whatever has
+// queued up with OrderBook::apply_batch (one write-lock hold per batch) and
+// completes each command's AsyncOp. Under contention the clients never wait
+// on the book lock, and the lock is taken once per batch, not per order.
+//
+// Clients reach the drain thread through SPSC rings, like MatchingEngine
+// producers: each client thread uses its own index in [0, num_clients).
+// One client's commands are applied in submission order. The book itself
+// stays usable directly; reads and other writers take its lock as usual.
+//
+// With nothing queued the drain thread polls for idle_spins rounds, then
+// sleeps until the next submit; SIZE_MAX keeps it busy-polling.
+template <typename LockPolicy = MutexPolicy, typename Levels = TickLadder>
+class AsyncBook {
+public:
+    using Book = OrderBook<LockPolicy, Levels>;
+
+    AsyncBook(Book& book, const AsyncConfig& cfg);
+    ~AsyncBook();
+
+    AsyncBook(const AsyncBook&) = delete;
+    AsyncBook& operator=(const AsyncBook&) = delete;
+
+    // Non-blocking; false if the client's queue is full. op may be null
+    // when the caller doesn't want the result.
+    bool try_submit(size_t client, const BookCommand& cmd, AsyncOp* op = nullptr);
+
+    // Spin (with yield) until the command is queued.
+    void submit(size_t client, const BookCommand& cmd, AsyncOp* op = nullptr);
+
+    // Block until every command queued so far has been applied.
+    void flush();
+
+    // Drain outstanding commands and join the drain thread. Idempotent.
+    void stop();
+
+    uint64_t processed() const { return processed_.load(std::memory_order_acquire); }
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }
+
+private:
+    struct Request {
+        BookCommand cmd;
+        AsyncOp*    op;
+    };
+
+    struct Client {
+        explicit Client(size_t capacity) : queue(capacity) {}
+        SpscQueue<Request> queue;
+        std::atomic<uint64_t> pushed{0};
+    };
+
+    void run();
+
+    Book& book_;
+    AsyncConfig cfg_;
+    std::vector<std::unique_ptr<Client>> clients_;
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<bool> running_{true};
+    QueueParker parker_;
+    std::thread thread_;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Image of a book's resting orders, for restarts and seeding replicas.
+// On disk: a 40-byte SnapshotHeader followed by fixed-size 32-byte
+// SnapshotOrders: all bids, best price first, then all asks, best price
+// first. Within a price, orders are in time priority. The side is given by
+// position and a level by a run of equal prices, so OrderBook::load() can
+// rebuild every queue in one pass without matching or lookups.
+
+struct SnapshotHeader {
+    char     magic[8];      // "OBSNAP\0\0"
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t bid_orders;
+    uint64_t ask_orders;
+    uint64_t exec_seq;      // last Execution::seq the book issued
+};
+
+struct SnapshotOrder {
+    uint64_t id;
+    uint64_t price;
+    uint32_t symbol_id;
+    uint32_t visible;       // quantity showing (an iceberg's current slice)
+    uint32_t peak;          // iceberg display size (0 = not an iceberg)
+    uint32_t reserve;       // iceberg hidden quantity
+};
+
+static_assert(sizeof(SnapshotHeader) == 40, "snapshot header layout");
+static_assert(sizeof(SnapshotOrder) == 32, "snapshot record layout");
+
+inline constexpr uint32_t kSnapshotVersion = 1;
+
+// In-memory snapshot. OrderBook::snapshot() refills one in place, so a
+// caller that keeps it around doesn't allocate on later snapshots.
+struct BookSnapshot {
+    uint64_t exec_seq = 0;
+    size_t bid_orders = 0;               // orders[0, bid_orders) are bids
+    std::vector<SnapshotOrder> orders;   // bids, then asks
+
+    const SnapshotOrder* bids_begin() const { return orders.data(); }
+    const SnapshotOrder* bids_end() const { return orders.data() + bid_orders; }
+    const SnapshotOrder* asks_begin() const { return bids_end(); }
+    const SnapshotOrder* asks_end() const { return orders.data() + orders.size(); }
+
+    // Throw std::runtime_error if the file cannot be written, or is missing,
+    // truncated, or not a snapshot of this version.
+    void save(const std::string& path) const;
+    static BookSnapshot read(const std::string& path);
+};
@@ -0,0 +1,213 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Instrumentation policies for OrderBook (third template parameter).
+//
+//   NoStatsPolicy        - every hook is an empty inline function; the
+//                          compiler drops the calls and the timestamps
+//   HistogramStatsPolicy - lock wait/hold and match-loop time per operation
+//                          in log-bucket histograms, plus book counters
+
+// Raw timestamp: TSC on x86, the virtual counter on ARM, steady_clock
+// nanoseconds elsewhere. Convert with ticks_per_ns().
+inline uint64_t read_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Measured once against steady_clock on first call (src/book_stats.cpp).
+double ticks_per_ns();
+
+// HDR-style histogram: values below 8 get their own bucket, larger ones go
+// into 8 linear sub-buckets per power of two (worst-case error 12.5%). The
+// whole uint64 range fits in a fixed 496 buckets, so recording never
+// allocates.
+class LogHistogram {
+public:
+    static constexpr int kSubBits = 3;
+    static constexpr int kSub     = 1 << kSubBits;
+    static constexpr int kBuckets = (64 - kSubBits + 1) * kSub;
+
+    static int bucket_of(uint64_t v) {
+        if (v < kSub) return static_cast<int>(v);
+        int e = 63 - __builtin_clzll(v);
+        int sub = static_cast<int>(v >> (e - kSubBits)) & (kSub - 1);
+        return (e - kSubBits + 1) * kSub + sub;
+    }
+    static uint64_t lower_bound_of(int b) {
+        if (b < kSub) return static_cast<uint64_t>(b);
+        int e = b / kSub - 1 + kSubBits;
+        return static_cast<uint64_t>(kSub | (b % kSub)) << (e - kSubBits);
+    }
+
+    void record(uint64_t v, uint64_t n = 1) {
+        counts_[bucket_of(v)] += n;
+        total_ += n;
+        sum_ += v * n;
+        if (v > max_) max_ = v;
+    }
+    // Merge n samples known only by bucket (counted at the bucket's lower bound).
+    void add_bucket(int b, uint64_t n) {
+        if (n == 0) return;
+        uint64_t v = lower_bound_of(b);
+        counts_[b] += n;
+        total_ += n;
+        sum_ += v * n;
+        if (v > max_) max_ = v;
+    }
+    void merge(const LogHistogram& o) {
+        for (int b = 0; b < kBuckets; ++b) counts_[b] += o.counts_[b];
+        total_ += o.total_;
+        sum_ += o.sum_;
+        if (o.max_ > max_) max_ = o.max_;
+    }
+
+    uint64_t count() const { return total_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_ ? static_cast<double>(sum_) / total_ : 0.0; }
+
+    // Lower bound of the bucket holding the p-th percentile (p in [0, 100]).
+    uint64_t percentile(double p) const {
+        if (total_ == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            seen += counts_[b];
+            if (seen >= rank) return lower_bound_of(b);
+        }
+        return max_;
+    }
+
+private:
+    uint64_t counts_[kBuckets] = {};
+    uint64_t total_ = 0;
+    uint64_t sum_   = 0;
+    uint64_t max_   = 0;
+};
+
+enum class BookOp : uint8_t { ADD, CANCEL, MODIFY, BATCH };
+inline constexpr int kBookOps = 4;
+
+// Merged view returned by HistogramStatsPolicy::snapshot(). Times are in
+// read_ticks() units.
+struct BookStatsSnapshot {
+    LogHistogram wait[kBookOps];   // acquiring the write lock, by BookOp
+    LogHistogram hold[kBookOps];   // holding it
+    LogHistogram match;            // match loop, for orders that traded
+    LogHistogram cancel_depth;     // orders resting on the level at cancel
+    uint64_t fills          = 0;
+    uint64_t levels_created = 0;
+    uint64_t levels_erased  = 0;
+};
+
+struct NoStatsPolicy {
+    static constexpr bool enabled = false;
+
+    uint64_t now() const { return 0; }
+    void on_op(BookOp, uint64_t, uint64_t, uint64_t) {}
+    void on_match(uint64_t, uint64_t) {}
+    void on_fill() {}
+    void on_level_created() {}
+    void on_level_erased() {}
+    void on_cancel(uint32_t) {}
+};
+
+// Each thread claims one of kSlots cache-line-aligned slots for its lifetime
+// and records into it with a plain load/add/store, no lock prefix. Threads
+// that find every slot taken record into one extra shared slot with atomic
+// fetch_add instead, so nothing is lost, just slower. snapshot() merges the
+// slots; it may run concurrently with recording.
+class HistogramStatsPolicy {
+public:
+    static constexpr bool enabled = true;
+    static constexpr size_t kSlots = 8;
+
+    HistogramStatsPolicy() : slots_(new Slot[kSlots + 1]) {}
+
+    uint64_t now() const { return read_ticks(); }
+
+    // t0: before the lock, t1: acquired, t2: done (still held)
+    void on_op(BookOp op, uint64_t t0, uint64_t t1, uint64_t t2) {
+        Mine m = mine();
+        m.slot.wait[static_cast<int>(op)].record(t1 - t0, m.shared);
+        m.slot.hold[static_cast<int>(op)].record(t2 - t1, m.shared);
+    }
+    void on_match(uint64_t t0, uint64_t t1) { Mine m = mine(); m.slot.match.record(t1 - t0, m.shared); }
+    void on_fill() { Mine m = mine(); bump(m.slot.fills, m.shared); }
+    void on_level_created() { Mine m = mine(); bump(m.slot.levels_created, m.shared); }
+    void on_level_erased() { Mine m = mine(); bump(m.slot.levels_erased, m.shared); }
+    void on_cancel(uint32_t level_count) {
+        Mine m = mine();
+        m.slot.cancel_depth.record(level_count, m.shared);
+    }
+
+    BookStatsSnapshot snapshot() const;   // src/book_stats.cpp
+
+private:
+    class AtomicHistogram {
+    public:
+        void record(uint64_t v, bool shared) { bump(counts_[LogHistogram::bucket_of(v)], shared); }
+        void add_to(LogHistogram& h) const {
+            for (int b = 0; b < LogHistogram::kBuckets; ++b)
+                h.add_bucket(b, counts_[b].load(std::memory_order_relaxed));
+        }
+
+    private:
+        std::atomic<uint64_t> counts_[LogHistogram::kBuckets] = {};
+    };
+
+    struct alignas(64) Slot {
+        AtomicHistogram wait[kBookOps];
+        AtomicHistogram hold[kBookOps];
+        AtomicHistogram match;
+        AtomicHistogram cancel_depth;
+        std::atomic<uint64_t> fills{0};
+        std::atomic<uint64_t> levels_created{0};
+        std::atomic<uint64_t> levels_erased{0};
+    };
+
+    // An owned slot has a single writer, so it needs no atomic RMW.
+    static void bump(std::atomic<uint64_t>& c, bool shared) {
+        if (shared)
+            c.fetch_add(1, std::memory_order_relaxed);
+        else
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // This thread's claim on slot `index` (kSlots = none free, use the shared
+    // one), process-wide and released when the thread exits.
+    struct SlotClaim {
+        SlotClaim();    // src/book_stats.cpp
+        ~SlotClaim();
+        size_t index;
+    };
+    static std::atomic<uint32_t> claimed_;   // bit i: slot i has an owner
+
+    struct Mine {
+        Slot& slot;
+        bool shared;
+    };
+
+    Mine mine() {
+        thread_local SlotClaim claim;
+        return {slots_[claim.index], claim.index == kSlots};
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include "order.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Read-only copy of a book's levels and resting orders, for readers that
+// walk the whole book (VWAP, depth, risk) and must not hold its lock while
+// they do. OrderBook::view() fills one; BookViews publishes them to reader
+// threads. Levels are best price first; each level's orders sit in
+// `orders` in time priority, starting at ViewLevel::first.
+
+struct ViewLevel {
+    uint64_t price;
+    uint64_t quantity;   // visible
+    uint32_t count;
+    uint32_t first;      // index of its first order in BookView::orders
+};
+
+struct ViewOrder {
+    uint64_t id;
+    uint32_t visible;
+    uint32_t reserve;    // iceberg hidden quantity
+};
+
+struct BookView {
+    uint64_t seq = 0;        // last LevelDelta reflected, as in BookDepth
+    uint64_t exec_seq = 0;   // last Execution::seq issued
+    std::vector<ViewLevel> bids;
+    std::vector<ViewLevel> asks;
+    std::vector<ViewOrder> orders;
+
+    const std::vector<ViewLevel>& levels(Side side) const {
+        return side == Side::BUY ? bids : asks;
+    }
+    const ViewOrder* orders_begin(const ViewLevel& l) const { return orders.data() + l.first; }
+    const ViewOrder* orders_end(const ViewLevel& l) const { return orders.data() + l.first + l.count; }
+
+    // Average price of taking up to qty of visible quantity from `side`,
+    // best price first; 0 if the side is empty. `filled` gets the quantity
+    // actually available (<= qty).
+    double vwap(Side side, uint64_t qty, uint64_t* filled = nullptr) const;
+
+    // Visible quantity at price or better (bids >= price, asks <= price).
+    uint64_t quantity_through(Side side, uint64_t price) const;
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include "book_view.h"
+#include "epoch.h"
+#include "order_book.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+struct ViewConfig {
+    size_t max_readers = 8;          // reader slots: each reader thread uses its own index
+    size_t max_levels  = SIZE_MAX;   // per side, copied into each view
+};
+
+// Read-copy-update views of an OrderBook for long-running readers (VWAP,
+// depth, risk). The publisher - normally the thread that writes the book,
+// between its own writes - copies the book into a BookView with
+// OrderBook::view() and swaps it in as the current view. Readers pin the
+// current view with read() and work on it for as long as they like without
+// any lock: a published view is never written again until every reader
+// that might hold it has let go (EpochDomain), after which it is reused for
+// a later publish. So readers never delay the writer, and the writer never
+// waits on readers; a reader only sees the book as of the last publish().
+//
+// publish() and reclaim() are for one thread at a time. Each reader thread
+// uses its own index in [0, max_readers) and holds one view at a time.
+template <typename LockPolicy = MutexPolicy, typename Levels = TickLadder>
+class BookViews {
+public:
+    using Book = OrderBook<LockPolicy, Levels>;
+
+    // A pinned view. Keeps the reader's epoch slot occupied until destroyed.
+    class Guard {
+    public:
+        Guard(Guard&& o) noexcept : epochs_(o.epochs_), reader_(o.reader_), view_(o.view_) {
+            o.epochs_ = nullptr;
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+        ~Guard() { if (epochs_) epochs_->exit(reader_); }
+
+        const BookView& operator*() const { return *view_; }
+        const BookView* operator->() const { return view_; }
+
+    private:
+        friend class BookViews;
+        Guard(EpochDomain* epochs, size_t reader, const BookView* view)
+            : epochs_(epochs), reader_(reader), view_(view) {}
+
+        EpochDomain* epochs_;
+        size_t reader_;
+        const BookView* view_;
+    };
+
+    // Publishes a first view, so read() always has one.
+    BookViews(const Book& book, const ViewConfig& cfg);
+
+    BookViews(const BookViews&) = delete;
+    BookViews& operator=(const BookViews&) = delete;
+
+    // Copy the book into a free view and make it current; the previous one
+    // is retired. Reclaims first, so in steady state this reuses a view's
+    // storage and doesn't allocate. Returns the new view's BookView::seq.
+    uint64_t publish();
+
+    // Pin the current view. Wait-free.
+    Guard read(size_t reader) const;
+
+    // Move retired views no reader can still hold to the free list.
+    // Returns how many.
+    size_t reclaim();
+
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    size_t retired() const { return retired_.size(); }      // publisher thread
+    size_t allocated() const { return owned_.size(); }      // publisher thread
+
+private:
+    const Book& book_;
+    ViewConfig cfg_;
+    mutable EpochDomain epochs_;
+    std::atomic<BookView*> current_{nullptr};
+    std::atomic<uint64_t> published_{0};
+
+    struct Retired {
+        uint64_t epoch;
+        BookView* view;
+    };
+    std::vector<std::unique_ptr<BookView>> owned_;
+    std::vector<BookView*> free_;
+    std::deque<Retired> retired_;   // in retirement (= epoch) order
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Epoch-based reclamation for one writer and a fixed set of readers.
+//
+// A reader brackets each read with enter()/exit() on its own slot. enter()
+// records the global epoch, so the slot says "may still hold anything that
+// was current at this epoch". The writer publishes a replacement first, then
+// calls advance() and keeps the old object until quiescent(epoch) says every
+// reader has either left or entered after that advance (and so can only
+// see the replacement). Readers never wait on anything; a reader that stays
+// inside one section only delays reclamation.
+//
+// Sections don't nest, and each slot belongs to one thread at a time.
+class EpochDomain {
+public:
+    explicit EpochDomain(size_t readers)
+        : readers_(readers ? readers : 1), slots_(new Slot[readers_]) {}
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    size_t readers() const { return readers_; }
+
+    void enter(size_t reader) {
+        slots_[reader].epoch.store(global_.load(std::memory_order_seq_cst),
+                                   std::memory_order_seq_cst);
+        // Loads of published pointers must not move above the slot store
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void exit(size_t reader) {
+        slots_[reader].epoch.store(kIdle, std::memory_order_release);
+    }
+
+    // Writer: call after publishing a replacement. Returns the epoch the
+    // replaced object was retired in.
+    uint64_t advance() { return global_.fetch_add(1, std::memory_order_seq_cst); }
+
+    // Oldest epoch any reader is inside, or kIdle if none is. Anything
+    // retired in an epoch below it can no longer be reached.
+    uint64_t oldest() const {
+        uint64_t e = kIdle;
+        for (size_t r = 0; r < readers_; ++r)
+            e = std::min(e, slots_[r].epoch.load(std::memory_order_seq_cst));
+        return e;
+    }
+
+    bool quiescent(uint64_t retired) const { return oldest() > retired; }
+
+    static constexpr uint64_t kIdle = UINT64_MAX;
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{kIdle};
+    };
+
+    std::atomic<uint64_t> global_{1};
+    size_t readers_;
+    std::unique_ptr<Slot[]> slots_;
+};
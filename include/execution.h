@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// One fill between a resting (maker) and an incoming (taker) order.
+// Trades at the maker's price. seq increases by one per fill within a book.
+struct Execution {
+    uint64_t maker_id;
+    uint64_t taker_id;
+    uint64_t price;
+    uint64_t quantity;
+    uint64_t seq;
+};
+
+// Caller-provided ring of execution reports. Storage is allocated once at
+// construction; push() never allocates, so the book can fill it from inside
+// the match loop. When the ring is full, new reports are dropped and
+// counted rather than overwriting ones the caller has not read yet.
+//
+// Not thread-safe: meant to be owned by the thread that calls add_order().
+class ExecutionRing {
+public:
+    explicit ExecutionRing(size_t capacity = 1024)
+        : mask_(round_up_pow2(capacity) - 1),
+          buf_(new Execution[mask_ + 1]) {}
+
+    bool push(const Execution& e) noexcept {
+        if (tail_ - head_ > mask_) {
+            ++dropped_;
+            return false;
+        }
+        buf_[tail_++ & mask_] = e;
+        return true;
+    }
+
+    bool pop(Execution& out) noexcept {
+        if (head_ == tail_) return false;
+        out = buf_[head_++ & mask_];
+        return true;
+    }
+
+    // i-th oldest unread report
+    const Execution& operator[](size_t i) const { return buf_[(head_ + i) & mask_]; }
+
+    size_t size() const { return static_cast<size_t>(tail_ - head_); }
+    bool empty() const { return head_ == tail_; }
+    size_t capacity() const { return mask_ + 1; }
+    uint64_t dropped() const { return dropped_; }
+
+    void clear() { head_ = tail_ = 0; dropped_ = 0; }
+
+private:
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    size_t mask_;
+    std::unique_ptr<Execution[]> buf_;
+    uint64_t head_ = 0;
+    uint64_t tail_ = 0;
+    uint64_t dropped_ = 0;
+};
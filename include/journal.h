@@ -0,0 +1,159 @@
+#pragma once
+#include "order.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// On-disk command journal: a 16-byte JournalHeader followed by fixed-size
+// 40-byte JournalRecords, one per accepted add/cancel/modify, in the
+// order the book applied them. Replaying the records through a fresh book
+// reproduces its state exactly.
+
+struct JournalHeader {
+    char     magic[8];      // "OBJRNL\0\0"
+    uint32_t version;
+    uint32_t record_size;
+};
+
+struct JournalRecord {
+    enum Kind : uint8_t { ADD = 1, CANCEL = 2, MODIFY = 3 };
+
+    uint8_t  kind;
+    uint8_t  side;          // Side
+    uint8_t  type;          // OrderType
+    uint8_t  flags;         // bits 0-1: TimeInForce, bit 2: post-only
+    uint32_t symbol_id;
+    uint64_t order_id;
+    uint64_t price;
+    uint64_t quantity;
+    uint64_t display_qty;
+};
+
+static_assert(sizeof(JournalHeader) == 16, "journal header layout");
+static_assert(sizeof(JournalRecord) == 40, "journal record layout");
+
+inline constexpr uint32_t kJournalVersion = 3;
+
+inline JournalRecord make_add_record(const Order& o) {
+    uint8_t flags = static_cast<uint8_t>(static_cast<uint8_t>(o.tif) | (o.post_only ? 4 : 0));
+    return JournalRecord{JournalRecord::ADD, static_cast<uint8_t>(o.side),
+                         static_cast<uint8_t>(o.type), flags,
+                         o.symbol_id, o.id, o.price, o.quantity, o.display_qty};
+}
+
+inline JournalRecord make_cancel_record(uint32_t symbol_id, uint64_t order_id) {
+    return JournalRecord{JournalRecord::CANCEL, 0, 0, 0, symbol_id, order_id, 0, 0, 0};
+}
+
+inline JournalRecord make_modify_record(uint32_t symbol_id, uint64_t order_id,
+                                        uint64_t price, uint64_t quantity) {
+    return JournalRecord{JournalRecord::MODIFY, 0, 0, 0, symbol_id, order_id, price, quantity, 0};
+}
+
+inline Order to_order(const JournalRecord& r) {
+    Order o{r.order_id, r.symbol_id, static_cast<OrderType>(r.type),
+            static_cast<Side>(r.side), r.price, r.quantity, r.quantity};
+    o.display_qty = r.display_qty;
+    o.tif = static_cast<TimeInForce>(r.flags & 3);
+    o.post_only = (r.flags & 4) != 0;
+    return o;
+}
+
+// Appends records with group commit. append() only copies the record into an
+// in-memory buffer; a background thread writes full buffers, and partially
+// filled ones every commit_interval, so the caller (holding the book lock)
+// never waits on I/O unless both buffers are full.
+//
+// Throws std::runtime_error if the file cannot be created or written. A
+// write (or sync) error on the background thread stops the journal; the next
+// append() or flush() rethrows it. The destructor drops it, so call flush()
+// before destroying a writer whose errors matter.
+class JournalWriter {
+public:
+    struct Options {
+        size_t buffer_records = 8192;
+        std::chrono::microseconds commit_interval{1000};
+        bool sync = false;          // fdatasync after every group write
+    };
+
+    explicit JournalWriter(const std::string& path) : JournalWriter(path, Options{}) {}
+    JournalWriter(const std::string& path, const Options& opts);
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    void append(const JournalRecord& r);
+
+    // Block until everything appended so far is written (and synced).
+    void flush();
+
+    uint64_t records_written() const;
+
+private:
+    void run_flusher();
+    void write_all(const void* data, size_t bytes);
+
+    Options opts_;
+    std::string path_;
+    int fd_ = -1;
+
+    mutable std::mutex mu_;
+    std::condition_variable work_cv_;   // flusher waits here
+    std::condition_variable done_cv_;   // appenders / flush() wait here
+    std::vector<JournalRecord> active_; // being appended to
+    std::vector<JournalRecord> spare_;  // handed to the flusher
+    bool spare_full_ = false;
+    bool stop_ = false;
+    uint64_t appended_ = 0;
+    uint64_t written_ = 0;
+    uint64_t flush_target_ = 0;
+    std::exception_ptr error_;          // set by the flusher, then it exits
+    std::thread flusher_;
+};
+
+// Read-only view of a journal file, memory-mapped where the platform
+// supports it. Records past the last complete one are ignored.
+//
+// Throws std::runtime_error if the file is missing or not a journal.
+class JournalReader {
+public:
+    explicit JournalReader(const std::string& path);
+    ~JournalReader();
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    const JournalRecord* begin() const { return records_; }
+    const JournalRecord* end() const { return records_ + count_; }
+    size_t size() const { return count_; }
+    const JournalRecord& operator[](size_t i) const { return records_[i]; }
+
+private:
+    void* map_ = nullptr;
+    size_t map_bytes_ = 0;
+    std::vector<char> fallback_;
+    const JournalRecord* records_ = nullptr;
+    size_t count_ = 0;
+};
+
+// Apply records [first, last) to a book. Returns how many the book accepted.
+template <typename Book>
+size_t replay(const JournalRecord* first, const JournalRecord* last, Book& book) {
+    size_t accepted = 0;
+    for (; first != last; ++first) {
+        if (first->kind == JournalRecord::ADD)
+            accepted += book.add_order(to_order(*first));
+        else if (first->kind == JournalRecord::MODIFY)
+            accepted += book.modify_order(first->order_id, first->price, first->quantity);
+        else
+            accepted += book.cancel_order(first->order_id);
+    }
+    return accepted;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Scans over a contiguous array of per-level quantities, best price first
+// (TickLadder keeps one per side). Each has an AVX2, an SSE2 and a scalar
+// version; the plain functions use the best one this CPU supports, picked
+// once at startup. Finding the next non-empty level is left to the ladder's
+// occupancy bitmap, which covers 64 levels per word.
+
+// Sum of q[0, n), except that it may stop once the running total reaches
+// `enough` (the result is then >= enough, not necessarily the full sum).
+uint64_t sum_until(const uint64_t* q, size_t n, uint64_t enough);
+
+struct LevelScanKernels {
+    const char* isa;   // "avx2", "sse2" or "scalar"
+    uint64_t (*sum_until)(const uint64_t* q, size_t n, uint64_t enough);
+};
+
+// The version in use, and every version this CPU can run (for tests and
+// benchmarks), best first.
+const LevelScanKernels& level_scan_kernels();
+std::vector<LevelScanKernels> available_level_scan_kernels();
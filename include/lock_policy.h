@@ -1,6 +1,8 @@
 #pragma once
+#include "spin_lock.h"
 #include <mutex>
 #include <shared_mutex>
+#include <type_traits>
 
 struct MutexPolicy {
     using mutex_type = std::mutex;
@@ -13,3 +15,53 @@ struct SharedMutexPolicy {
     using read_lock  = std::shared_lock<std::shared_mutex>;
     using write_lock = std::unique_lock<std::shared_mutex>;
 };
+
+// TTAS spinlock with PAUSE/yield backoff. Reads and writes both exclusive.
+struct SpinLockPolicy {
+    using mutex_type = SpinLock;
+    using read_lock  = std::unique_lock<SpinLock>;
+    using write_lock = std::unique_lock<SpinLock>;
+};
+
+// FIFO ticket lock: acquisition order equals arrival order.
+struct TicketLockPolicy {
+    using mutex_type = TicketLock;
+    using read_lock  = std::unique_lock<TicketLock>;
+    using write_lock = std::unique_lock<TicketLock>;
+};
+
+// Spin-then-park: ~100 spins, then futex wait.
+struct AdaptiveLockPolicy {
+    using mutex_type = AdaptiveMutex;
+    using read_lock  = std::unique_lock<AdaptiveMutex>;
+    using write_lock = std::unique_lock<AdaptiveMutex>;
+};
+
+// No locking at all. Only valid when a single thread owns the book, e.g. a
+// MatchingEngine shard that is the sole consumer of its inbound queues.
+struct NullLockPolicy {
+    struct mutex_type {};
+    struct lock_type {
+        explicit lock_type(mutex_type&) {}
+    };
+    using read_lock  = lock_type;
+    using write_lock = lock_type;
+};
+
+// Writers serialize on a std::mutex. After every write the book publishes
+// best bid/ask through a seqlock, so best_bid_price(), best_ask_price() and
+// top_of_book() never touch the mutex.
+struct SeqLockPolicy {
+    using mutex_type = std::mutex;
+    using read_lock  = std::unique_lock<std::mutex>;
+    using write_lock = std::unique_lock<std::mutex>;
+    static constexpr bool seqlock_top_of_book = true;
+};
+
+// True if LP declares seqlock_top_of_book = true.
+template <typename LP, typename = void>
+struct uses_seqlock_top : std::false_type {};
+
+template <typename LP>
+struct uses_seqlock_top<LP, std::void_t<decltype(LP::seqlock_top_of_book)>>
+    : std::bool_constant<LP::seqlock_top_of_book> {};
@@ -0,0 +1,32 @@
+#pragma once
+#include "order.h"
+#include <cstdint>
+#include <vector>
+
+// One aggregated price level.
+struct LevelInfo {
+    uint64_t price;
+    uint64_t quantity;
+    uint32_t order_count;
+};
+
+// Top-N levels per side, best first. `seq` is the sequence number of the
+// last LevelDelta the book had emitted when the snapshot was taken, so a
+// feed consumer can apply only deltas with a larger seq on top of it.
+struct BookDepth {
+    std::vector<LevelInfo> bids;
+    std::vector<LevelInfo> asks;
+    uint64_t seq = 0;
+};
+
+// New state of one price level after a write. quantity == 0 (and
+// order_count == 0) means the level is gone. seq increases by one per delta
+// within a book, so a gap tells the consumer it missed updates (the feed
+// queue was full) and should resync from depth().
+struct LevelDelta {
+    uint64_t seq;
+    uint64_t price;
+    uint64_t quantity;
+    uint32_t order_count;
+    Side     side;
+};
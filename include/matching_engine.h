@@ -0,0 +1,103 @@
+#pragma once
+#include "order_book.h"
+#include "spsc_queue.h"
+#include "thread_placement.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Command carried from a producer to a shard thread.
+struct EngineCommand {
+    enum class Kind : uint8_t { ADD, CANCEL };
+
+    Kind     kind;
+    uint32_t symbol_id;
+    uint64_t order_id;   // CANCEL
+    Order    order;      // ADD
+};
+
+struct EngineConfig {
+    size_t       num_shards     = 1;
+    size_t       num_producers  = 1;
+    size_t       queue_capacity = 4096;   // per producer × shard queue
+    BookConfig   book           = BookConfig{};       // every book: price band, reserved sizes
+    std::vector<uint32_t> symbols;                    // books built up front (others on first add)
+    Placement    placement      = Placement::NONE;  // shard i → i-th CPU of the layout
+    size_t       idle_spins     = 4096;   // empty polls (with yield) before a shard sleeps
+};
+
+// Per-shard counters. Written only by the shard thread.
+struct ShardStats {
+    uint64_t processed = 0;
+    uint64_t rejected  = 0;
+    uint64_t fills     = 0;
+};
+
+// Owns one OrderBook per symbol, sharded by symbol_id across N threads.
+// Each shard thread is the only writer of its books, so they run with
+// NullLockPolicy. Producers talk to shards through SPSC rings: producer p
+// writes only to queue (p, shard), shard s reads only from queues (*, s).
+//
+// Producer indices are fixed: each producer thread must use its own index
+// in [0, num_producers) and never share it with another thread.
+//
+// An idle shard polls its queues (yielding) for idle_spins rounds, then
+// sleeps until a producer pushes to it; the first command after that pays
+// a wake-up. Set idle_spins to SIZE_MAX to keep shards busy-polling.
+template <typename Levels = TickLadder>
+class MatchingEngine {
+public:
+    using Book = OrderBook<NullLockPolicy, Levels>;
+
+    explicit MatchingEngine(const EngineConfig& cfg);
+    ~MatchingEngine();
+
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    // Non-blocking; false if the producer's queue to that shard is full.
+    bool try_add_order(size_t producer, const Order& order);
+    bool try_cancel_order(size_t producer, uint32_t symbol_id, uint64_t order_id);
+
+    // Spin (with yield) until the command is queued.
+    void add_order(size_t producer, const Order& order);
+    void cancel_order(size_t producer, uint32_t symbol_id, uint64_t order_id);
+
+    // Block until every command queued so far has been applied.
+    void flush();
+
+    // Drain outstanding commands and join the shard threads. Idempotent.
+    void stop();
+
+    size_t shard_of(uint32_t symbol_id) const { return symbol_id % shards_.size(); }
+    size_t num_shards() const { return shards_.size(); }
+
+    // Only safe while no commands are in flight (after flush() or stop()).
+    const Book* book(uint32_t symbol_id) const;
+    ShardStats stats(size_t shard) const;
+
+private:
+    struct Shard {
+        std::vector<std::unique_ptr<SpscQueue<EngineCommand>>> inbound;  // one per producer
+        std::vector<std::atomic<uint64_t>> pushed;                        // per producer
+        std::unordered_map<uint32_t, std::unique_ptr<Book>> books;
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> fills{0};
+        QueueParker parker;
+        std::thread thread;
+
+        explicit Shard(size_t producers) : pushed(producers) {}
+    };
+
+    bool try_push(size_t producer, const EngineCommand& cmd);
+    void run_shard(size_t index);
+    void apply(Shard& shard, const EngineCommand& cmd, ExecutionRing& fills);
+
+    EngineConfig cfg_;
+    std::vector<int> shard_cpus_;   // from plan_threads(); -1 = unpinned
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> running_{true};
+};
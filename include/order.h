@@ -12,6 +12,14 @@ enum class OrderType {
     MARKET
 };
 
+// GTC rests any unfilled remainder; IOC drops it; FOK fills completely
+// or not at all. Market orders never rest, whatever their time in force.
+enum class TimeInForce : uint8_t {
+    GTC,
+    IOC,
+    FOK
+};
+
 struct Order {
     uint64_t id;
     uint32_t symbol_id;
@@ -22,7 +30,14 @@ struct Order {
     uint64_t price;
     uint64_t quantity;
     uint64_t remaining;
-    
+
+    // Iceberg: when resting, show at most display_qty and keep the rest in
+    // a hidden reserve that refills the visible slice at the back of the
+    // queue. 0 = fully displayed.
+    uint64_t display_qty = 0;
+    TimeInForce tif = TimeInForce::GTC;
+    bool post_only = false;     // reject instead of crossing
+
     static Order Limit(uint64_t id, uint32_t symbol, Side side, 
                        uint64_t price, uint64_t qty) {
         return Order{id, symbol, OrderType::LIMIT, side, price, qty, qty};
@@ -31,6 +46,16 @@ struct Order {
     static Order Market(uint64_t id, uint32_t symbol, Side side, uint64_t qty) {
         return Order{id, symbol, OrderType::MARKET, side, 0, qty, qty};
     }
+
+    static Order Iceberg(uint64_t id, uint32_t symbol, Side side,
+                         uint64_t price, uint64_t qty, uint64_t display) {
+        Order o = Limit(id, symbol, side, price, qty);
+        o.display_qty = display;
+        return o;
+    }
+
+    Order& with_tif(TimeInForce t) { tif = t; return *this; }
+    Order& with_post_only() { post_only = true; return *this; }
     
     bool is_filled() const { return remaining == 0; }
 };
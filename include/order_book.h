@@ -1,37 +1,256 @@
 #pragma once
 #include "order.h"
+#include "book_snapshot.h"
+#include "book_view.h"
+#include "book_stats.h"
+#include "execution.h"
+#include "journal.h"
 #include "lock_policy.h"
-#include <map>
-#include <unordered_map>
+#include "market_depth.h"
+#include "order_id_registry.h"
+#include "order_index.h"
+#include "order_pool.h"
+#include "price_levels.h"
+#include "spsc_queue.h"
+#include "top_of_book.h"
 #include <optional>
-#include <list>
 
-template <typename LockPolicy = SharedMutexPolicy>
+// Up-front sizing for OrderBook. The constructor allocates room for
+// max_orders resting orders and max_levels price levels per side; while the
+// book stays within both, add/cancel/modify and matching make no heap
+// allocations. (An attached journal or delta feed is the caller's.)
+struct BookConfig {
+    LadderConfig ladder;
+    size_t max_orders = 0;
+    size_t max_levels = 0;   // per side
+};
+
+// One item of a mixed batch (OrderBook::apply_batch, AsyncBook).
+struct BookCommand {
+    enum class Kind : uint8_t { ADD, CANCEL, MODIFY };
+
+    Kind  kind;
+    Order order;   // ADD: the order. CANCEL: order.id. MODIFY: order.id and
+                   // the new order.price / order.quantity.
+
+    static BookCommand Add(const Order& o) { return {Kind::ADD, o}; }
+    static BookCommand Cancel(uint64_t id) {
+        Order o{};
+        o.id = id;
+        return {Kind::CANCEL, o};
+    }
+    static BookCommand Modify(uint64_t id, uint64_t price, uint64_t qty) {
+        Order o{};
+        o.id = id;
+        o.price = price;
+        o.quantity = qty;
+        return {Kind::MODIFY, o};
+    }
+};
+
+// What one command did.
+struct BookResult {
+    bool     accepted = false;   // what the single-order call would return
+    uint32_t fills = 0;          // executions it caused as the taker
+    uint64_t filled_qty = 0;     // quantity those executions traded
+};
+
+template <typename LockPolicy = SharedMutexPolicy, typename Levels = MapLevels,
+          typename StatsPolicy = NoStatsPolicy>
 class OrderBook {
 public:
     OrderBook() = default;
+    explicit OrderBook(const LadderConfig& cfg)
+        : bids_(cfg), asks_(cfg) {}
+    explicit OrderBook(const BookConfig& cfg) : OrderBook(cfg.ladder) {
+        reserve(cfg.max_orders, cfg.max_levels);
+    }
+
+    // Grow storage to the BookConfig limits now rather than on first use.
+    // Never shrinks.
+    void reserve(size_t max_orders, size_t max_levels);
 
-    bool add_order(const Order& order);
+    // Limit orders match against the opposite side up to their limit price
+    // and rest any remainder; market orders sweep until filled or the side
+    // is empty. One Execution per fill is pushed to `fills` if given.
+    //
+    // A duplicate of a resting id is usually rejected before taking the
+    // lock, as is a cancel or modify of an id that isn't resting (see
+    // OrderIdRegistry).
+    //
+    // Order::tif and Order::post_only are applied within the same call:
+    //   IOC        - match, then drop the remainder instead of resting it
+    //   FOK        - rejected (false, book untouched) unless the visible
+    //                quantity within the limit covers the whole order
+    //   post_only  - rejected if the order would cross on arrival
+    //   iceberg    - see Order::display_qty; shows only a slice when resting
+    // GTC limit orders above kMaxRestingQuantity are rejected.
+    bool add_order(const Order& order, ExecutionRing* fills = nullptr);
     bool cancel_order(uint64_t order_id);
 
+    // Amend a resting order in one lock hold, reusing its node. new_qty is
+    // the total quantity left (including any iceberg reserve).
+    //   same price, new_qty <= left - in place, keeps time priority
+    //   same price, larger new_qty  - moves to the back of its level
+    //   new price                   - leaves its level; trades like an
+    //                                 incoming limit order if it now crosses,
+    //                                 and rests any remainder at the back
+    // Returns false (nothing changes) for an unknown id, new_qty == 0,
+    // new_qty above kMaxRestingQuantity, or a price the side can't store.
+    bool modify_order(uint64_t order_id, uint64_t new_price, uint64_t new_qty,
+                      ExecutionRing* fills = nullptr);
+
+    // Batch forms: the whole batch runs under one write-lock hold, in the
+    // order given. status[i] gets what the single-order call would have
+    // returned for item i. Return the number of items that succeeded.
+    size_t add_orders(const Order* orders, size_t count, bool* status,
+                      ExecutionRing* fills = nullptr);
+    size_t cancel_orders(const uint64_t* order_ids, size_t count, bool* status);
+
+    // Mixed batch under one write-lock hold, in the order given. results[i]
+    // also counts the fills command i caused; fills go to `fills` as usual.
+    size_t apply_batch(const BookCommand* cmds, size_t count, BookResult* results,
+                       ExecutionRing* fills = nullptr);
+
     std::optional<uint64_t> best_bid_price() const;
     std::optional<uint64_t> best_ask_price() const;
 
+    // Best bid/ask and their sizes from one consistent book state. Lock-free
+    // under SeqLockPolicy; one read-lock hold otherwise.
+    TopOfBook top_of_book() const;
+
+    // Top n aggregated levels per side, read from the per-level running
+    // totals (no order-list scans).
+    BookDepth depth(size_t n) const;
+
+    // Visible quantity resting on `side` at price or better (bids >= price,
+    // asks <= price): what a limit order at price could take from it,
+    // iceberg reserves aside. On TickLadder a vector sum over the side's
+    // level quantities (level_scan.h) rather than a walk of the levels.
+    uint64_t quantity_through(Side side, uint64_t price) const;
+
+    // Incremental L2 feed. Once attached, every write pushes one LevelDelta
+    // per price level it changed. Pushes happen under the write lock, so the
+    // lock serializes the queue's producer side even with several writer
+    // threads; one consumer thread may drain it concurrently. A full queue
+    // drops the delta (seq still advances, so the consumer sees the gap).
+    void set_delta_feed(SpscQueue<LevelDelta>* feed);
+    uint64_t dropped_deltas() const;
+
+    // Command journal. Once attached, every accepted add/cancel is appended
+    // under the write lock, in apply order; replay() of the journal into an
+    // empty book rebuilds this one. Records are appended before the command
+    // is applied, so a journal error thrown from add/cancel/modify leaves the
+    // book unchanged. Pass nullptr to detach.
+    void set_journal(JournalWriter* journal);
+
+    // Copy every resting order into `out` under one read-lock hold: a linear
+    // walk of the levels writing 32 bytes per order. `out` is grown with
+    // the lock released if it's too small, so a reused snapshot adds no
+    // allocation to the writer stall.
+    void snapshot(BookSnapshot& out) const;
+
+    // Copy the best max_levels levels per side, with their orders, into
+    // `out` under one read-lock hold, for readers that then work on the copy
+    // without the lock (see book_views.h). Grows `out` the way snapshot()
+    // does.
+    void view(BookView& out, size_t max_levels = SIZE_MAX) const;
+
+    // Rebuild this book, which must be empty, from a snapshot in one
+    // write-lock hold. Nodes, index and levels are sized once and filled
+    // directly, with no matching or per-order lookups. Returns false, and
+    // leaves the book empty, if the image isn't one a book could hold
+    // (unsorted or crossed prices, prices the side can't store, bad
+    // quantities, repeated ids). One LevelDelta per loaded level goes to the
+    // delta feed. Nothing is journaled; a journal started after load() is
+    // replayed on top of the snapshot.
+    bool load(const BookSnapshot& snap);
+
+    // Instrumentation (see book_stats.h). With HistogramStatsPolicy,
+    // stats().snapshot() gives lock wait/hold and match-loop histograms and
+    // book counters; with the default NoStatsPolicy nothing is recorded.
+    const StatsPolicy& stats() const { return stats_; }
+
     size_t total_orders() const;
     size_t total_bid_levels() const;
     size_t total_ask_levels() const;
 
 private:
+    static constexpr bool kSeqlockTop = uses_seqlock_top<LockPolicy>::value;
+    // Single-threaded books have no lock worth skipping
+    static constexpr bool kIdFilter = !std::is_same_v<LockPolicy, NullLockPolicy>;
+
     mutable typename LockPolicy::mutex_type mtx_;
+    TopOfBookSeqLock top_;
+    StatsPolicy stats_;
+
+    // Each side is its own type (price_levels.h), so code templated on the
+    // side compiles to one branch-free version per side.
+    using BidLevels = typename Levels::template side<Side::BUY>;
+    using AskLevels = typename Levels::template side<Side::SELL>;
+
+    BidLevels bids_;
+    AskLevels asks_;
+    OrderPool pool_;
+    OrderIndex orders_;
+    OrderIdRegistry registry_;   // resting ids, readable without mtx_ (kIdFilter)
+    uint64_t exec_seq_ = 0;
+    uint64_t traded_qty_ = 0;   // running total of executed quantity
+    TopOfBook published_;   // last published top of book (write lock held)
+
+    // Level the previous resting insert went to. Consecutive inserts at the
+    // same side and price (common in bursts) skip the level lookup. Cleared
+    // whenever any level is erased, since that may free the cached one.
+    struct LevelHint {
+        Side side = Side::BUY;
+        uint64_t price = 0;
+        PriceLevel* level = nullptr;
+    } hint_;
+
+    SpscQueue<LevelDelta>* delta_feed_ = nullptr;
+    uint64_t delta_seq_ = 0;
+    uint64_t deltas_dropped_ = 0;
+    JournalWriter* journal_ = nullptr;
 
-    std::map<uint64_t, std::list<Order>> bids_;
-    std::map<uint64_t, std::list<Order>> asks_;
-    std::unordered_map<uint64_t, Order*> orders_;
+    template <Side S> auto& levels() {
+        if constexpr (S == Side::BUY) return bids_;
+        else                          return asks_;
+    }
+    template <Side S> const auto& levels() const {
+        if constexpr (S == Side::BUY) return bids_;
+        else                          return asks_;
+    }
 
-    void add_limit_order(const Order& order);
-    void match_market_order(Order order);
-    void execute_trade(Order& incoming, Order& resting, uint64_t exec_qty);
+    // The *_locked entry points look at the order's side once and continue
+    // in the version of the path specialized for it.
+    bool add_order_locked(const Order& order, ExecutionRing* fills);
+    bool cancel_order_locked(uint64_t order_id);
+    bool modify_order_locked(uint64_t order_id, uint64_t new_price, uint64_t new_qty,
+                             ExecutionRing* fills);
+    template <Side S> bool add_side(const Order& order, ExecutionRing* fills);
+    template <Side S> bool modify_side(OrderNode* node, uint64_t new_price, uint64_t new_qty,
+                                       ExecutionRing* fills);
+    void index_order(uint64_t id, OrderNode* node);
+    OrderNode* unindex_order(uint64_t id);
+    void grow_registry(size_t capacity);
+    bool snapshot_fits(const BookSnapshot& snap, size_t& bid_levels, size_t& ask_levels) const;
+    template <Side S> bool load_side(const SnapshotOrder* first, const SnapshotOrder* last);
+    void clear_locked();
+    template <Side S> void add_limit_order(const Order& order);
+    template <Side S> void match_order(Order& order, ExecutionRing* fills);   // S: taker side
+    void take_level(Order& order, PriceLevel& level, uint64_t price, ExecutionRing* fills);
+    void execute_trade(Order& incoming, OrderNode& resting, uint64_t price,
+                       uint64_t exec_qty, ExecutionRing* fills);
+    template <Side S> void remove_node(OrderNode* node);
+    template <Side S> bool crosses(const Order& order) const;
+    template <Side S> uint64_t fillable_quantity(const Order& order) const;
+    void update_top();
+    template <Side S> void level_changed(uint64_t price, const PriceLevel& level);
 };
 
 using ExclusiveOrderBook = OrderBook<MutexPolicy>;
 using SharedOrderBook    = OrderBook<SharedMutexPolicy>;
+using ExclusiveLadderBook = OrderBook<MutexPolicy, TickLadder>;
+using SharedLadderBook    = OrderBook<SharedMutexPolicy, TickLadder>;
+using SeqLockOrderBook    = OrderBook<SeqLockPolicy>;
+using SeqLockLadderBook   = OrderBook<SeqLockPolicy, TickLadder>;
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Lock-free filter over the ids resting in a book, so add_order can reject a
+// duplicate and cancel_order/modify_order an unknown id without taking the
+// book lock. The book updates it under its write lock (one writer at a
+// time); any thread may query it concurrently.
+//
+// Each id hashes to one slot, which holds that id if it is the only resting
+// id there, kEmpty if there is none, or kShared if there are several. A query
+// answers only when its slot is decisive; otherwise the caller takes the lock
+// and asks the order index. Answers reflect the book at some instant during
+// the query, so a rejection is one the locked path could have given too.
+//
+// The table is replaced by one twice as large when it gets half full.
+// A reader still holding the old table sees it frozen at the moment of the
+// switch, which is again a state of the book during its call, so retired
+// tables are only freed with the registry.
+class OrderIdRegistry {
+public:
+    explicit OrderIdRegistry(size_t capacity = 1024) { publish(capacity, [](auto&&) {}); }
+
+    OrderIdRegistry(const OrderIdRegistry&) = delete;
+    OrderIdRegistry& operator=(const OrderIdRegistry&) = delete;
+
+    // === Readers (any thread, no lock) ===
+
+    bool surely_absent(uint64_t id) const {
+        if (is_sentinel(id)) return false;
+        uint64_t v = load_slot(id);
+        return v == kEmpty || (v != kShared && v != id);
+    }
+
+    bool surely_present(uint64_t id) const {
+        return !is_sentinel(id) && load_slot(id) == id;
+    }
+
+    // === Writer (book write lock held) ===
+
+    void insert(uint64_t id) {
+        Table& t = *current_;
+        size_t i = t.index(id);
+        uint32_t c = ++t.counts[i];
+        t.slots[i].store(c == 1 && !is_sentinel(id) ? id : kShared, std::memory_order_release);
+        ++live_;
+    }
+
+    void erase(uint64_t id) {
+        Table& t = *current_;
+        size_t i = t.index(id);
+        if (--t.counts[i] == 0)
+            t.slots[i].store(kEmpty, std::memory_order_release);
+        --live_;
+    }
+
+    void prefetch(uint64_t id) const {
+        size_t i = current_->index(id);
+        __builtin_prefetch(&current_->slots[i], 1);
+        __builtin_prefetch(&current_->counts[i], 1);
+    }
+
+    // True once inserting more would leave the table over half full.
+    bool full() const { return (live_ + 1) * 2 > current_->size(); }
+
+    // Switch to a table with room for `capacity` ids, filled from
+    // for_each_id(add), which must call add(id) for every resting id.
+    template <typename ForEachId>
+    void rebuild(size_t capacity, ForEachId&& for_each_id) {
+        if (slots_for(capacity) > current_->size())
+            publish(capacity, for_each_id);
+    }
+
+private:
+    static constexpr uint64_t kEmpty  = 0;
+    static constexpr uint64_t kShared = UINT64_MAX;
+
+    static bool is_sentinel(uint64_t id) { return id == kEmpty || id == kShared; }
+
+    static size_t slots_for(size_t capacity) {
+        size_t n = 2;
+        while (n < 2 * capacity) n <<= 1;
+        return n;
+    }
+
+    struct Table {
+        explicit Table(size_t n)
+            : slots(new std::atomic<uint64_t>[n]), counts(n, 0),
+              mask(n - 1), shift(64 - __builtin_ctzll(n)) {
+            for (size_t i = 0; i < n; ++i)
+                slots[i].store(kEmpty, std::memory_order_relaxed);
+        }
+
+        size_t size() const { return mask + 1; }
+        size_t index(uint64_t id) const { return (id * 0x9E3779B97F4A7C15ull) >> shift; }
+
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        std::vector<uint32_t> counts;   // resting ids per slot; writer only
+        size_t mask;
+        int shift;
+    };
+
+    uint64_t load_slot(uint64_t id) const {
+        const Table* t = table_.load(std::memory_order_acquire);
+        return t->slots[t->index(id)].load(std::memory_order_acquire);
+    }
+
+    template <typename ForEachId>
+    void publish(size_t capacity, ForEachId&& for_each_id) {
+        tables_.push_back(std::make_unique<Table>(slots_for(capacity)));
+        current_ = tables_.back().get();
+        live_ = 0;
+        for_each_id([this](uint64_t id) { insert(id); });
+        table_.store(current_, std::memory_order_release);
+    }
+
+    std::atomic<const Table*> table_{nullptr};   // what readers use
+    Table* current_ = nullptr;                    // same table, writer's view
+    size_t live_ = 0;
+    std::vector<std::unique_ptr<Table>> tables_;  // current last; earlier ones retired
+};
@@ -0,0 +1,225 @@
+#pragma once
+#include "order_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Order id → resting node, replacing std::unordered_map<uint64_t, OrderNode*>:
+// no allocation per insert, no rehash once reserved, and a lookup touches
+// one or two cache lines. Two parts:
+//
+//   - a dense window: a ring of W slots indexed directly by id, covering ids
+//     [lo, lo + W). Ids are mostly assigned in increasing order, so new
+//     orders land here without hashing or probing. The window slides up as
+//     higher ids arrive; orders still live below it (deep resting orders)
+//     move to the table.
+//   - an open-addressing table (linear probing, Fibonacci hashing) for
+//     everything else. Erase shifts later entries back instead of leaving
+//     tombstones, so probe lengths don't degrade under cancel churn. The
+//     table doubles at half full; reserve() sizes it up front.
+//
+// An id inside the window is only ever stored in the window. Ids far above
+// it (a jump of more than W while the window holds orders) go to the table
+// and are pulled into the window when it slides over them.
+class OrderIndex {
+public:
+    explicit OrderIndex(size_t capacity = 1024) { reserve(capacity); }
+
+    OrderIndex(const OrderIndex&) = delete;
+    OrderIndex& operator=(const OrderIndex&) = delete;
+
+    OrderNode* find(uint64_t id) const {
+        if (id - lo_ < dense_.size())
+            return dense_[id & dense_mask_];
+        return table_count_ ? table_find(id) : nullptr;
+    }
+
+    // False (nothing changes) if id is already present.
+    bool insert(uint64_t id, OrderNode* node) {
+        if (id - lo_ >= dense_.size()) {
+            bool ahead = id > lo_;
+            bool near = id - lo_ < 2 * dense_.size();
+            if (!ahead || (!near && dense_count_ > 0)) {
+                if (!table_put(id, node)) return false;
+                if (ahead) {   // above the window: pulled in when the window reaches it
+                    ++far_count_;
+                    far_min_ = std::min(far_min_, id);
+                }
+                return true;
+            }
+            slide_to(id);
+        }
+        OrderNode*& slot = dense_[id & dense_mask_];
+        if (slot) return false;
+        slot = node;
+        ++dense_count_;
+        return true;
+    }
+
+    // Remove id and return its node, or nullptr if absent.
+    OrderNode* extract(uint64_t id) {
+        if (id - lo_ < dense_.size()) {
+            OrderNode*& slot = dense_[id & dense_mask_];
+            OrderNode* node = slot;
+            if (node) {
+                slot = nullptr;
+                --dense_count_;
+            }
+            return node;
+        }
+        if (table_count_ == 0) return nullptr;
+        size_t i = table_slot(id);
+        OrderNode* node = table_[i].node;
+        if (node) {
+            if (id > lo_) --far_count_;
+            table_erase_at(i);
+        }
+        return node;
+    }
+
+    bool erase(uint64_t id) { return extract(id) != nullptr; }
+
+    // Hint that id is about to be looked up or inserted (bulk loads, where
+    // ids arrive in price order rather than id order).
+    void prefetch(uint64_t id) const {
+        if (id - lo_ < dense_.size())
+            __builtin_prefetch(&dense_[id & dense_mask_], 1);
+        else if (!table_.empty())
+            __builtin_prefetch(&table_[home(id)], 1);
+    }
+
+    // Room for n live orders without growing: a window of at least n ids
+    // and a table that stays under half full with n entries.
+    void reserve(size_t n) {
+        size_t window = pow2_at_least(n);
+        if (window > dense_.size()) {
+            std::vector<OrderNode*> old(window, nullptr);
+            old.swap(dense_);
+            for (uint64_t id = lo_; id < lo_ + old.size(); ++id)
+                dense_[id & (window - 1)] = old[id & (old.size() - 1)];
+            dense_mask_ = window - 1;
+            if (far_count_) migrate_far();
+        }
+        size_t slots = pow2_at_least(2 * n);
+        if (slots > table_.size())
+            rehash(slots);
+    }
+
+    size_t size() const { return dense_count_ + table_count_; }
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Slot {
+        uint64_t id;
+        OrderNode* node;   // nullptr: empty
+    };
+
+    static size_t pow2_at_least(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    size_t home(uint64_t id) const { return (id * 0x9E3779B97F4A7C15ull) >> table_shift_; }
+
+    // Slot holding id, or the empty slot that ends its probe sequence.
+    size_t table_slot(uint64_t id) const {
+        size_t i = home(id);
+        while (table_[i].node && table_[i].id != id)
+            i = (i + 1) & table_mask_;
+        return i;
+    }
+
+    OrderNode* table_find(uint64_t id) const { return table_[table_slot(id)].node; }
+
+    bool table_put(uint64_t id, OrderNode* node) {
+        if ((table_count_ + 1) * 2 > table_.size())
+            rehash(table_.size() * 2);
+        size_t i = table_slot(id);
+        if (table_[i].node) return false;
+        table_[i] = Slot{id, node};
+        ++table_count_;
+        return true;
+    }
+
+    // Backward-shift deletion: later entries of the same probe run move up
+    // into the hole unless that would put them before their home slot.
+    void table_erase_at(size_t i) {
+        for (size_t j = (i + 1) & table_mask_; table_[j].node; j = (j + 1) & table_mask_) {
+            size_t k = home(table_[j].id);
+            bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (!stays) {
+                table_[i] = table_[j];
+                i = j;
+            }
+        }
+        table_[i].node = nullptr;
+        --table_count_;
+    }
+
+    void rehash(size_t slots) {
+        std::vector<Slot> old(slots, Slot{0, nullptr});
+        old.swap(table_);
+        table_mask_ = slots - 1;
+        table_shift_ = 64 - __builtin_ctzll(slots);
+        for (const Slot& s : old) {
+            if (!s.node) continue;
+            size_t i = home(s.id);
+            while (table_[i].node) i = (i + 1) & table_mask_;
+            table_[i] = s;
+        }
+    }
+
+    // Move the window up so id is its highest slot. Live entries that fall
+    // off the bottom go to the table (each id moves at most once, so this is
+    // amortized O(1) per insert for increasing ids).
+    void slide_to(uint64_t id) {
+        uint64_t new_lo = id + 1 - dense_.size();
+        uint64_t end = std::min<uint64_t>(new_lo, lo_ + dense_.size());
+        for (uint64_t x = lo_; x < end && dense_count_ > 0; ++x) {
+            OrderNode*& slot = dense_[x & dense_mask_];
+            if (slot) {
+                table_put(x, slot);
+                slot = nullptr;
+                --dense_count_;
+            }
+        }
+        lo_ = new_lo;
+        if (far_count_ && far_min_ < lo_ + dense_.size())
+            migrate_far();
+    }
+
+    // Rare: move table entries the window now covers into it, then recount
+    // what is still above. Erasing at i shifts a later entry back into i, so
+    // i is checked again before moving on.
+    void migrate_far() {
+        for (size_t i = 0; i < table_.size(); ++i) {
+            while (table_[i].node && table_[i].id - lo_ < dense_.size()) {
+                dense_[table_[i].id & dense_mask_] = table_[i].node;
+                ++dense_count_;
+                table_erase_at(i);
+            }
+        }
+        far_count_ = 0;
+        far_min_ = UINT64_MAX;
+        for (const Slot& s : table_) {
+            if (s.node && s.id > lo_) {
+                ++far_count_;
+                far_min_ = std::min(far_min_, s.id);
+            }
+        }
+    }
+
+    std::vector<OrderNode*> dense_;
+    size_t dense_mask_ = 0;
+    uint64_t lo_ = 0;
+    size_t dense_count_ = 0;
+
+    std::vector<Slot> table_;
+    size_t table_mask_ = 0;
+    int table_shift_ = 64;
+    size_t table_count_ = 0;
+    size_t far_count_ = 0;         // table entries with id above the window
+    uint64_t far_min_ = UINT64_MAX;
+};
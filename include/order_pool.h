@@ -0,0 +1,183 @@
+#pragma once
+#include "order.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct PriceLevel;
+
+// Resting orders are split in two. OrderNode holds what the match loop reads
+// for every order it walks (links, id, remaining) and packs two to a cache
+// line; OrderCold holds the rest and is only read on cancel. A resting
+// order's quantities are 32-bit, so limit orders above kMaxRestingQuantity
+// are rejected by the book.
+inline constexpr uint64_t kMaxRestingQuantity = UINT32_MAX;
+
+struct OrderNode {
+    OrderNode* prev;
+    OrderNode* next;
+    uint64_t id;
+    uint32_t remaining;     // visible quantity
+    uint32_t slot : 31;     // index of this node's OrderCold; fixed per node
+    uint32_t iceberg : 1;   // hidden reserve left in OrderCold
+};
+
+struct OrderCold {
+    uint64_t price;         // full width: MapLevels has no tick base
+    PriceLevel* level;
+    uint32_t symbol_id;
+    uint32_t peak;          // iceberg display size (0 = not an iceberg)
+    uint32_t reserve;       // iceberg hidden quantity
+    uint8_t flags;          // bit 0: SELL
+
+    Side side() const { return (flags & 1) ? Side::SELL : Side::BUY; }
+};
+
+static_assert(sizeof(OrderNode) == 32, "two hot nodes per cache line");
+static_assert(sizeof(OrderCold) == 32, "cold order layout");
+
+// Intrusive FIFO of the orders resting at one price. Does not own its
+// nodes; the book returns them to the OrderPool when they leave the level.
+// `quantity` is the running sum of the nodes' remaining quantities; the book
+// decrements it on partial fills (push_back/unlink keep it in sync otherwise).
+struct PriceLevel {
+    OrderNode* head = nullptr;
+    OrderNode* tail = nullptr;
+    uint64_t quantity = 0;
+    uint32_t count = 0;
+
+    bool empty() const { return head == nullptr; }
+
+    void push_back(OrderNode* node) {
+        node->prev = tail;
+        node->next = nullptr;
+        if (tail) tail->next = node;
+        else      head = node;
+        tail = node;
+        quantity += node->remaining;
+        ++count;
+    }
+
+    void unlink(OrderNode* node) {
+        if (node->prev) node->prev->next = node->next;
+        else            head = node->next;
+        if (node->next) node->next->prev = node->prev;
+        else            tail = node->prev;
+        quantity -= node->remaining;
+        --count;
+    }
+
+    void clear() {
+        head = tail = nullptr;
+        quantity = 0;
+        count = 0;
+    }
+};
+
+// Slab allocator for OrderNodes. Nodes are carved out of fixed-size chunks
+// and recycled through a free list, so steady-state add/cancel never touches
+// the heap. A new chunk is allocated only when the free list runs dry. Cold
+// halves live in a parallel array indexed by OrderNode::slot.
+class OrderPool {
+public:
+    explicit OrderPool(size_t chunk_size = 4096) : chunk_size_(chunk_size) {}
+
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    // order.remaining must not exceed kMaxRestingQuantity. An iceberg
+    // (0 < display_qty < remaining) starts with display_qty visible.
+    OrderNode* acquire(const Order& order, PriceLevel* level) {
+        if (!free_) grow();
+        OrderNode* node = free_;
+        free_ = node->next;
+        node->prev = node->next = nullptr;
+        node->id = order.id;
+
+        OrderCold& c = cold_[node->slot];
+        c.price = order.price;
+        c.level = level;
+        c.symbol_id = order.symbol_id;
+        c.flags = order.side == Side::SELL ? 1 : 0;
+
+        bool iceberg = order.display_qty > 0 && order.display_qty < order.remaining;
+        uint64_t visible = iceberg ? order.display_qty : order.remaining;
+        node->remaining = static_cast<uint32_t>(visible);
+        node->iceberg = iceberg;
+        c.peak = iceberg ? static_cast<uint32_t>(order.display_qty) : 0;
+        c.reserve = static_cast<uint32_t>(order.remaining - visible);
+        return node;
+    }
+
+    // Quantity left: visible slice plus any hidden iceberg reserve.
+    uint64_t total_remaining(const OrderNode* node) const {
+        return uint64_t{node->remaining} + cold_[node->slot].reserve;
+    }
+
+    // Shrink to qty (<= total_remaining) in place; the reserve goes first.
+    void reduce(OrderNode* node, uint32_t qty) {
+        OrderCold& c = cold_[node->slot];
+        if (qty >= node->remaining) {
+            c.reserve = qty - node->remaining;
+        } else {
+            node->remaining = qty;
+            c.reserve = 0;
+        }
+        node->iceberg = c.reserve > 0;
+    }
+
+    // Set qty as if the order had just arrived (icebergs re-cut their slice).
+    void reset_quantity(OrderNode* node, uint32_t qty) {
+        OrderCold& c = cold_[node->slot];
+        node->remaining = (c.peak && c.peak < qty) ? c.peak : qty;
+        c.reserve = qty - node->remaining;
+        node->iceberg = c.reserve > 0;
+    }
+
+    // Refill an iceberg's exhausted visible slice from its reserve. Returns
+    // false once the reserve is gone. The caller re-queues the node.
+    bool replenish(OrderNode* node) {
+        OrderCold& c = cold_[node->slot];
+        uint32_t slice = c.reserve < c.peak ? c.reserve : c.peak;
+        c.reserve -= slice;
+        node->remaining = slice;
+        node->iceberg = c.reserve > 0;
+        return slice > 0;
+    }
+
+    void release(OrderNode* node) {
+        node->next = free_;
+        free_ = node;
+    }
+
+    OrderCold& cold(const OrderNode* node) { return cold_[node->slot]; }
+    const OrderCold& cold(const OrderNode* node) const { return cold_[node->slot]; }
+
+    size_t capacity() const { return cold_.size(); }
+
+    // Allocate nodes for n orders in one chunk now, so acquire() doesn't
+    // have to until more than n are resting.
+    void reserve(size_t n) {
+        if (n > capacity())
+            grow(n - capacity());
+    }
+
+private:
+    void grow() { grow(chunk_size_); }
+
+    void grow(size_t count) {
+        chunks_.emplace_back(new OrderNode[count]);
+        OrderNode* chunk = chunks_.back().get();
+        uint32_t base = static_cast<uint32_t>(cold_.size());
+        cold_.resize(cold_.size() + count);
+        for (size_t i = count; i-- > 0;) {
+            chunk[i].slot = base + static_cast<uint32_t>(i);
+            release(&chunk[i]);
+        }
+    }
+
+    size_t chunk_size_;
+    OrderNode* free_ = nullptr;
+    std::vector<std::unique_ptr<OrderNode[]>> chunks_;
+    std::vector<OrderCold> cold_;
+};
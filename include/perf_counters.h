@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+
+// Hardware event counts for the calling thread, from perf_event_open(2):
+// retired instructions, cycles, branches and branch misses, user space only.
+// The four run as one group, so they cover exactly the same stretch of code.
+// Counting needs Linux, a PMU the VM exposes and perf_event_paranoid <= 2;
+// where any is missing available() is false and every count stays zero.
+
+struct PerfCounts {
+    uint64_t instructions  = 0;
+    uint64_t cycles        = 0;
+    uint64_t branches      = 0;
+    uint64_t branch_misses = 0;
+};
+
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return leader_ >= 0; }
+
+    // Counts accumulate over every start()/stop() stretch since reset().
+    void start();
+    void stop();
+    void reset();
+    PerfCounts read() const;
+
+private:
+    int leader_ = -1;
+    int fds_[4] = {-1, -1, -1, -1};
+};
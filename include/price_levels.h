@@ -0,0 +1,315 @@
+#pragma once
+#include "level_scan.h"
+#include "order.h"
+#include "order_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+// Level storage backends for OrderBook. A backend is a family of two
+// classes, Backend::side<Side::BUY> for the bids and side<Side::SELL> for
+// the asks. The side is a template parameter, so which end is "best", every
+// price comparison and the direction of every search are fixed at compile
+// time and each side's code has no side branches.
+//
+// Each side class exposes the same interface:
+//   accepts(price)   - can this price be stored at all
+//   level(price)     - level at price, created if absent (like map::operator[])
+//   erase(price)     - drop the level at price
+//   best()           - best level, or nullptr if the side is empty
+//   pop_best()       - drop the best level
+//   best_price()     - price of the best level
+//   size() / empty() - number of non-empty levels
+//   reserve(n)       - room for n levels without allocating
+//   for_each_from_best(n, f) - f(price, level) for up to n levels, best first;
+//                      if f returns bool, false stops the walk early
+//   set_quantity(price, q)    - the book changed the level's quantity
+//   quantity_through(price, enough) - summed quantity of the levels from the
+//                      best through price; may stop once it reaches enough
+
+// Price order of one side, best first: bids descending, asks ascending.
+template <Side S>
+struct PriceOrder {
+    static constexpr Side opposite = S == Side::BUY ? Side::SELL : Side::BUY;
+
+    // Worst possible price: a taker limited to it reaches every level
+    static constexpr uint64_t worst = S == Side::BUY ? 0 : UINT64_MAX;
+
+    static constexpr bool better(uint64_t a, uint64_t b) {
+        if constexpr (S == Side::BUY) return a > b;
+        else                          return a < b;
+    }
+    // A level at `price` is within `limit` (as good as limit or better)
+    static constexpr bool within(uint64_t price, uint64_t limit) {
+        return !better(limit, price);
+    }
+
+    using compare = std::conditional_t<S == Side::BUY, std::greater<uint64_t>, std::less<uint64_t>>;
+};
+
+namespace detail {
+template <typename F>
+bool visit_level(F& f, uint64_t price, const PriceLevel& level) {
+    if constexpr (std::is_same_v<decltype(f(price, level)), bool>) {
+        return f(price, level);
+    } else {
+        f(price, level);
+        return true;
+    }
+}
+}  // namespace detail
+
+// Price band covered by a TickLadder. Prices below base_price, above the
+// last level, or not on a tick boundary are rejected by accepts().
+struct LadderConfig {
+    uint64_t base_price = 0;
+    uint64_t tick_size  = 1;
+    size_t   num_levels = 16384;
+};
+
+// Free list of std::map nodes. Erased levels keep their node for the next
+// insert, so once reserve() has created enough of them, creating and erasing
+// levels never touches the heap. Nodes are carved out of chunks, like
+// OrderPool; the node size is fixed by the first allocation.
+class NodeArena {
+public:
+    explicit NodeArena(size_t chunk_nodes = 64) : chunk_nodes_(chunk_nodes) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    void* allocate(size_t bytes) {
+        if (node_size_ == 0) node_size_ = round_up(bytes);
+        if (round_up(bytes) != node_size_) return ::operator new(bytes);
+        if (!free_) grow();
+        void* p = free_;
+        free_ = *static_cast<void**>(p);
+        return p;
+    }
+
+    void deallocate(void* p, size_t bytes) {
+        if (round_up(bytes) != node_size_) {
+            ::operator delete(p);
+            return;
+        }
+        *static_cast<void**>(p) = free_;
+        free_ = p;
+    }
+
+private:
+    static size_t round_up(size_t bytes) {
+        constexpr size_t a = alignof(std::max_align_t);
+        return (bytes + a - 1) / a * a;
+    }
+
+    void grow() {
+        size_t words = (chunk_nodes_ * node_size_ + sizeof(std::max_align_t) - 1)
+                     / sizeof(std::max_align_t);
+        chunks_.emplace_back(new std::max_align_t[words]);
+        char* base = reinterpret_cast<char*>(chunks_.back().get());
+        for (size_t i = chunk_nodes_; i-- > 0;)
+            deallocate(base + i * node_size_, node_size_);
+    }
+
+    size_t chunk_nodes_;
+    size_t node_size_ = 0;
+    void* free_ = nullptr;
+    std::vector<std::unique_ptr<std::max_align_t[]>> chunks_;
+};
+
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    explicit ArenaAllocator(NodeArena* a) : arena(a) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& o) : arena(o.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(n == 1 ? arena->allocate(sizeof(T)) : ::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) {
+        if (n == 1) arena->deallocate(p, sizeof(T));
+        else        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& o) const { return arena == o.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& o) const { return arena != o.arena; }
+
+    NodeArena* arena;
+};
+
+// std::map keyed by price, ordered best first, so the best level is always
+// begin(). Unbounded price range, O(log n) level lookup. Map nodes come from
+// a NodeArena.
+template <Side S>
+class MapSide {
+public:
+    using level_type = PriceLevel;
+
+    explicit MapSide(const LadderConfig& = LadderConfig{})
+        : arena_(std::make_unique<NodeArena>()), levels_(Alloc(arena_.get())) {}
+
+    bool accepts(uint64_t) const { return true; }
+
+    // Build n nodes in a scratch map sharing the arena and free them again.
+    void reserve(size_t n) {
+        Map scratch{Alloc(arena_.get())};
+        for (size_t i = 0; i < n; ++i)   // keys in map order, so each goes at end()
+            scratch.emplace_hint(scratch.end(), S == Side::BUY ? n - i : i, level_type{});
+    }
+
+    level_type& level(uint64_t price) { return levels_[price]; }
+    void erase(uint64_t price) { levels_.erase(price); }
+
+    level_type* best() { return levels_.empty() ? nullptr : &levels_.begin()->second; }
+    const level_type* best() const { return levels_.empty() ? nullptr : &levels_.begin()->second; }
+
+    void pop_best() { levels_.erase(levels_.begin()); }
+
+    std::optional<uint64_t> best_price() const {
+        if (levels_.empty()) return std::nullopt;
+        return levels_.begin()->first;
+    }
+
+    size_t size() const { return levels_.size(); }
+    bool empty() const { return levels_.empty(); }
+
+    void set_quantity(uint64_t, uint64_t) {}   // read from the levels themselves
+
+    uint64_t quantity_through(uint64_t price, uint64_t enough) const {
+        uint64_t total = 0;
+        for (auto it = levels_.begin(); it != levels_.end(); ++it) {
+            if (!PriceOrder<S>::within(it->first, price)) break;
+            total += it->second.quantity;
+            if (total >= enough) break;
+        }
+        return total;
+    }
+
+    template <typename F>
+    void for_each_from_best(size_t n, F&& f) const {
+        for (auto it = levels_.begin(); it != levels_.end() && n > 0; ++it, --n)
+            if (!detail::visit_level(f, it->first, it->second)) return;
+    }
+
+private:
+    using Alloc = ArenaAllocator<std::pair<const uint64_t, level_type>>;
+    using Map = std::map<uint64_t, level_type, typename PriceOrder<S>::compare, Alloc>;
+
+    std::unique_ptr<NodeArena> arena_;   // declared first: outlives levels_
+    Map levels_;
+};
+
+// Contiguous array of levels indexed by (price - base_price) / tick_size.
+// Occupied levels are tracked in a bitmap and the best index is cached, so
+// best-price reads are a single load and level lookup is an array index.
+// Level quantities are also kept in a dense array ordered best price first
+// (ascending for asks, descending for bids), so quantity_through() is one
+// vector sum (level_scan.h) instead of a walk over the 32-byte levels.
+template <Side S>
+class TickSide {
+public:
+    using level_type = PriceLevel;
+
+    explicit TickSide(const LadderConfig& cfg = LadderConfig{});
+
+    bool accepts(uint64_t price) const {
+        if (price < cfg_.base_price) return false;
+        uint64_t offset = price - cfg_.base_price;
+        return offset % cfg_.tick_size == 0
+            && offset / cfg_.tick_size < cfg_.num_levels;
+    }
+
+    level_type& level(uint64_t price);
+    void erase(uint64_t price) { erase_index(index_of(price)); }
+
+    level_type* best() {
+        return best_ == npos ? nullptr : &levels_[best_];
+    }
+    const level_type* best() const {
+        return best_ == npos ? nullptr : &levels_[best_];
+    }
+
+    void pop_best() { erase_index(best_); }
+
+    std::optional<uint64_t> best_price() const {
+        if (best_ == npos) return std::nullopt;
+        return price_of(best_);
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    void reserve(size_t) {}   // every level is allocated up front
+
+    void set_quantity(uint64_t price, uint64_t qty) { qty_[rank_of(index_of(price))] = qty; }
+    uint64_t quantity_through(uint64_t price, uint64_t enough) const;
+
+    template <typename F>
+    void for_each_from_best(size_t n, F&& f) const {
+        for (size_t idx = best_; idx != npos && n > 0;) {
+            if (!detail::visit_level(f, price_of(idx), levels_[idx])) return;
+            if (--n == 0) return;   // don't search past the last level wanted
+            idx = next_after(idx);
+        }
+    }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    size_t index_of(uint64_t price) const {
+        return static_cast<size_t>((price - cfg_.base_price) / cfg_.tick_size);
+    }
+    uint64_t price_of(size_t idx) const {
+        return cfg_.base_price + static_cast<uint64_t>(idx) * cfg_.tick_size;
+    }
+
+    // Position in qty_: distance from the side's best end of the ladder
+    size_t rank_of(size_t idx) const {
+        if constexpr (S == Side::BUY) return cfg_.num_levels - 1 - idx;
+        else                          return idx;
+    }
+
+    bool occupied(size_t idx) const {
+        return (bitmap_[idx >> 6] >> (idx & 63)) & 1;
+    }
+
+    // Best occupied level at idx or worse / strictly worse than idx
+    size_t next_from(size_t idx) const {
+        if constexpr (S == Side::BUY) return next_down(idx);
+        else                          return next_up(idx);
+    }
+    size_t next_after(size_t idx) const {
+        if constexpr (S == Side::BUY) return idx == 0 ? npos : next_down(idx - 1);
+        else                          return idx + 1 == cfg_.num_levels ? npos : next_up(idx + 1);
+    }
+
+    void erase_index(size_t idx);
+    size_t next_up(size_t idx) const;    // lowest occupied index >= idx
+    size_t next_down(size_t idx) const;  // highest occupied index <= idx
+
+    LadderConfig cfg_;
+    std::vector<level_type> levels_;
+    std::vector<uint64_t> qty_;      // levels_[i].quantity at rank_of(i)
+    std::vector<uint64_t> bitmap_;
+    size_t best_  = npos;
+    size_t count_ = 0;
+};
+
+// Backend families, the Levels argument of OrderBook.
+struct MapLevels {
+    template <Side S> using side = MapSide<S>;
+};
+
+struct TickLadder {
+    template <Side S> using side = TickSide<S>;
+};
@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Spin-wait hint: PAUSE on x86, YIELD on ARM.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Exponential backoff for spin loops: PAUSE up to a cap, then give the core
+// away so a preempted lock holder can run.
+class SpinBackoff {
+public:
+    void pause() {
+        if (spins_ < kYieldAfter) {
+            for (uint32_t i = 0; i < spins_ + 1; ++i)
+                cpu_relax();
+            spins_ = spins_ * 2 + 1;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr uint32_t kYieldAfter = 64;
+    uint32_t spins_ = 0;
+};
+
+// Test-and-test-and-set spinlock. Waiters spin on a plain load so the cache
+// line stays shared until the holder releases it.
+class SpinLock {
+public:
+    void lock() {
+        SpinBackoff backoff;
+        for (;;) {
+            if (!locked_.exchange(true, std::memory_order_acquire))
+                return;
+            while (locked_.load(std::memory_order_relaxed))
+                backoff.pause();
+        }
+    }
+
+    bool try_lock() {
+        return !locked_.load(std::memory_order_relaxed)
+            && !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() { locked_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> locked_{false};
+};
+
+// FIFO ticket lock. Every waiter takes a ticket and spins until it is served,
+// so no thread can be starved by faster ones re-acquiring.
+class TicketLock {
+public:
+    void lock() {
+        uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        SpinBackoff backoff;
+        while (serving_.load(std::memory_order_acquire) != ticket)
+            backoff.pause();
+    }
+
+    bool try_lock() {
+        uint32_t serving = serving_.load(std::memory_order_acquire);
+        uint32_t expected = serving;
+        return next_.compare_exchange_strong(expected, serving + 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> next_{0};
+    alignas(64) std::atomic<uint32_t> serving_{0};
+};
+
+// Spin briefly, then sleep in the kernel (futex on Linux, yield elsewhere).
+// state_: 0 = unlocked, 1 = locked, 2 = locked with possible sleepers.
+class AdaptiveMutex {
+public:
+    void lock() {
+        for (int i = 0; i < kSpinLimit; ++i) {
+            uint32_t expected = 0;
+            if (state_.load(std::memory_order_relaxed) == 0 &&
+                state_.compare_exchange_weak(expected, 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+                return;
+            cpu_relax();
+        }
+        lock_slow();
+    }
+
+    bool try_lock() {
+        uint32_t expected = 0;
+        return state_.compare_exchange_strong(expected, 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        if (state_.exchange(0, std::memory_order_release) == 2)
+            wake_one();
+    }
+
+private:
+    static constexpr int kSpinLimit = 100;
+
+    void lock_slow();   // src/spin_lock.cpp
+    void wake_one();
+
+    std::atomic<uint32_t> state_{0};
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+// Bounded lock-free single-producer/single-consumer ring. Capacity is rounded
+// up to a power of two. The producer and consumer indices sit on separate
+// cache lines, and each side keeps a private copy of the other's index so it
+// only touches the shared line when the ring looks full (or empty).
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1),
+          buf_(new T[mask_ + 1]) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool try_push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_)
+                return false;
+        }
+        buf_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+                return false;
+        }
+        out = buf_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side; exact only when the other side is quiescent
+    size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire)
+             - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size_approx() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const size_t mask_;
+    const std::unique_ptr<T[]> buf_;
+
+    alignas(64) std::atomic<size_t> head_{0};   // written by consumer
+    size_t cached_tail_ = 0;                    // consumer's view of tail_
+
+    alignas(64) std::atomic<size_t> tail_{0};   // written by producer
+    size_t cached_head_ = 0;                    // producer's view of head_
+};
+
+// Lets the consumer of one or more rings sleep once they have been empty for
+// a while, instead of polling an idle core at 100%. The consumer calls
+// park(has_work) and producers call notify() after every push. While the
+// consumer is awake notify() is a fence and a load; it takes the mutex only
+// to wake a sleeping consumer. wake() wakes it unconditionally (shutdown).
+class QueueParker {
+public:
+    template <typename HasWork>
+    void park(HasWork has_work) {
+        std::unique_lock<std::mutex> lk(mu_);
+        sleeping_.store(true, std::memory_order_relaxed);
+        // Pairs with notify(): either it sees sleeping_, or has_work() sees the push
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_work())
+            cv_.wait(lk, [this] { return woken_; });
+        woken_ = false;
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed))
+            wake();
+    }
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            woken_ = true;
+        }
+        cv_.notify_one();
+    }
+
+private:
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::atomic<bool> sleeping_{false};
+    bool woken_ = false;   // guarded by mu_
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Thread placement: which logical CPU each worker runs on.
+//
+// Memory follows the thread. Linux places a page on the NUMA node of the
+// thread that first touches it, so a book constructed and filled by its
+// pinned owner thread keeps its ladder, order index and pool chunks on that
+// thread's node. run_on_cpu() builds an object on a given CPU for the case
+// where the owner thread does not exist yet.
+
+struct CpuInfo {
+    int cpu;      // logical CPU number (what sched_setaffinity takes)
+    int core;     // physical core id, unique within a socket
+    int socket;   // physical package id
+    int node;     // NUMA node (0 when the kernel reports none)
+};
+
+// The logical CPUs this process may run on, as reported by sysfs.
+class CpuTopology {
+public:
+    // Reads /sys/devices/system/cpu for every CPU in the affinity mask.
+    // Elsewhere (or if sysfs is missing) every CPU is its own core on
+    // socket 0, node 0.
+    static CpuTopology detect();
+
+    explicit CpuTopology(std::vector<CpuInfo> cpus);
+
+    const std::vector<CpuInfo>& cpus() const { return cpus_; }
+    const CpuInfo* find(int cpu) const;
+    size_t sockets() const;
+    size_t nodes() const;
+
+private:
+    std::vector<CpuInfo> cpus_;   // ascending cpu number
+};
+
+// How a run's threads are laid out. Thread i gets the i-th CPU of the
+// layout's order; more threads than CPUs wrap around.
+//
+//   NONE    - no pinning; the scheduler decides
+//   COMPACT - logical CPUs in numeric order
+//   SMT     - fill both hardware threads of a core before the next core
+//             (pairs share L1/L2)
+//   SOCKET  - one thread per physical core of the first socket, then
+//             their SMT siblings, then the next socket
+//   CROSS   - one thread per physical core, alternating sockets, so every
+//             lock handoff crosses the interconnect
+enum class Placement { NONE, COMPACT, SMT, SOCKET, CROSS };
+
+const char* placement_name(Placement p);
+// Accepts the lowercase names above; false if unknown.
+bool parse_placement(const std::string& name, Placement& out);
+
+// One CPU per thread; -1 (don't pin) for every thread under NONE.
+std::vector<int> plan_threads(const CpuTopology& topo, Placement p, size_t threads);
+
+// Pin the calling thread. cpu < 0 is a no-op returning true. False if the
+// kernel refused (or on platforms without affinity).
+bool pin_current_thread(int cpu);
+
+// CPU the calling thread is running on now, or -1 if unknown.
+int current_cpu();
+
+// Run f() on a thread pinned to cpu and wait for it, so memory f() first
+// touches is placed on that CPU's node. Returns f()'s result.
+template <typename F>
+auto run_on_cpu(int cpu, F&& f) -> decltype(f()) {
+    using R = decltype(f());
+    if constexpr (std::is_void_v<R>) {
+        std::thread t([&] { pin_current_thread(cpu); f(); });
+        t.join();
+    } else {
+        R result{};
+        std::thread t([&] { pin_current_thread(cpu); result = f(); });
+        t.join();
+        return result;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "spin_lock.h"
+#include <atomic>
+#include <cstdint>
+
+// Best bid/ask with the aggregate quantity resting at each. A side with no
+// orders has qty == 0 (and price == 0). seq counts publications; two
+// snapshots with the same seq describe the same book state.
+struct TopOfBook {
+    uint64_t bid_price = 0;
+    uint64_t bid_qty   = 0;
+    uint64_t ask_price = 0;
+    uint64_t ask_qty   = 0;
+    uint64_t seq       = 0;
+
+    bool has_bid() const { return bid_qty != 0; }
+    bool has_ask() const { return ask_qty != 0; }
+};
+
+// Single-writer seqlock around a TopOfBook, on its own cache line.
+// The writer (holding the book's write lock) bumps the sequence to odd,
+// stores the fields, then bumps it back to even. Readers retry until they
+// see the same even sequence before and after copying the fields, so they
+// never block the writer and never observe a torn bid/ask pair.
+class alignas(64) TopOfBookSeqLock {
+public:
+    void publish(const TopOfBook& t) {
+        uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        bid_price_.store(t.bid_price, std::memory_order_relaxed);
+        bid_qty_.store(t.bid_qty, std::memory_order_relaxed);
+        ask_price_.store(t.ask_price, std::memory_order_relaxed);
+        ask_qty_.store(t.ask_qty, std::memory_order_relaxed);
+
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    TopOfBook read() const {
+        TopOfBook t;
+        for (;;) {
+            uint64_t s1 = seq_.load(std::memory_order_acquire);
+            if (s1 & 1) {
+                cpu_relax();
+                continue;
+            }
+
+            t.bid_price = bid_price_.load(std::memory_order_relaxed);
+            t.bid_qty   = bid_qty_.load(std::memory_order_relaxed);
+            t.ask_price = ask_price_.load(std::memory_order_relaxed);
+            t.ask_qty   = ask_qty_.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == s1) {
+                t.seq = s1 / 2;
+                return t;
+            }
+        }
+    }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> bid_price_{0};
+    std::atomic<uint64_t> bid_qty_{0};
+    std::atomic<uint64_t> ask_price_{0};
+    std::atomic<uint64_t> ask_qty_{0};
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include "thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Work-stealing loop over independent tasks 0..n-1, for coarse tasks of
+// very uneven size (one per symbol in a backtest).
+//
+// Worker w starts with the contiguous share [w·n/T, (w+1)·n/T) and runs it
+// from the front. A worker whose share is empty steals the back half of
+// another worker's remaining share and carries on with that. A share is one
+// atomic word (begin and end, 32 bits each), so taking a task and stealing
+// are single CASes on it and no lock is involved. Tasks are handed out in
+// index order within a share, so callers put expensive tasks first and deal
+// them across shares (see deal_by_cost()).
+
+struct StealStats {
+    size_t tasks  = 0;   // tasks this worker ran
+    size_t steals = 0;   // successful steals
+};
+
+namespace detail {
+
+struct alignas(64) StealRange {
+    std::atomic<uint64_t> span{0};   // begin | end << 32
+};
+
+inline uint64_t pack_span(uint32_t begin, uint32_t end) {
+    return uint64_t{begin} | (uint64_t{end} << 32);
+}
+
+// Owner: take the first task.
+inline bool pop_front(StealRange& r, uint32_t& task) {
+    uint64_t s = r.span.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t b = static_cast<uint32_t>(s), e = static_cast<uint32_t>(s >> 32);
+        if (b >= e) return false;
+        if (r.span.compare_exchange_weak(s, pack_span(b + 1, e), std::memory_order_acq_rel)) {
+            task = b;
+            return true;
+        }
+    }
+}
+
+// Thief: take the back half (rounded up) of what's left.
+inline bool steal_back(StealRange& r, uint32_t& begin, uint32_t& end) {
+    uint64_t s = r.span.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t b = static_cast<uint32_t>(s), e = static_cast<uint32_t>(s >> 32);
+        if (b >= e) return false;
+        uint32_t mid = e - (e - b + 1) / 2;
+        if (r.span.compare_exchange_weak(s, pack_span(b, mid), std::memory_order_acq_rel)) {
+            begin = mid;
+            end = e;
+            return true;
+        }
+    }
+}
+
+}  // namespace detail
+
+// Run f(task, worker) for every task in [0, n) on one thread per entry of
+// cpus (each pinned there; -1 = unpinned) and wait. Returns per-worker
+// counts. A worker stops once every share it looks at is empty; tasks in a
+// share being stolen at that moment are run by the thief.
+template <typename F>
+std::vector<StealStats> run_work_stealing(size_t n, const std::vector<int>& cpus, F&& f) {
+    size_t workers = cpus.empty() ? 1 : cpus.size();
+    std::unique_ptr<detail::StealRange[]> ranges(new detail::StealRange[workers]);
+    for (size_t w = 0; w < workers; ++w)
+        ranges[w].span.store(detail::pack_span(static_cast<uint32_t>(w * n / workers),
+                                               static_cast<uint32_t>((w + 1) * n / workers)),
+                             std::memory_order_relaxed);
+
+    std::vector<StealStats> stats(workers);
+    auto work = [&](size_t w) {
+        if (!cpus.empty()) pin_current_thread(cpus[w]);
+        detail::StealRange& own = ranges[w];
+        StealStats local;
+        for (;;) {
+            uint32_t task;
+            if (detail::pop_front(own, task)) {
+                f(static_cast<size_t>(task), w);
+                ++local.tasks;
+                continue;
+            }
+            // Look for a victim, starting with the next worker along
+            bool stole = false;
+            for (size_t k = 1; k < workers && !stole; ++k) {
+                uint32_t b, e;
+                if (detail::steal_back(ranges[(w + k) % workers], b, e)) {
+                    own.span.store(detail::pack_span(b, e), std::memory_order_release);
+                    ++local.steals;
+                    stole = true;
+                }
+            }
+            if (!stole) break;
+        }
+        stats[w] = local;
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; ++w)
+        threads.emplace_back(work, w);
+    work(0);
+    for (auto& t : threads) t.join();
+    return stats;
+}
+
+// Task order for run_work_stealing(): indices sorted by descending cost,
+// dealt round-robin into the workers' initial shares, so every share starts
+// with a fair mix and the largest tasks start first.
+template <typename Cost>
+std::vector<size_t> deal_by_cost(const std::vector<Cost>& cost, size_t workers) {
+    std::vector<size_t> by_cost(cost.size());
+    for (size_t i = 0; i < by_cost.size(); ++i) by_cost[i] = i;
+    std::stable_sort(by_cost.begin(), by_cost.end(),
+                     [&](size_t a, size_t b) { return cost[a] > cost[b]; });
+
+    if (workers == 0) workers = 1;
+    size_t n = cost.size();
+    std::vector<size_t> next(workers), end(workers);   // same shares as run_work_stealing()
+    for (size_t w = 0; w < workers; ++w) {
+        next[w] = w * n / workers;
+        end[w] = (w + 1) * n / workers;
+    }
+
+    std::vector<size_t> order(n);
+    size_t w = 0;
+    for (size_t task : by_cost) {
+        while (next[w] == end[w]) w = (w + 1) % workers;
+        order[next[w]++] = task;
+        w = (w + 1) % workers;
+    }
+    return order;
+}
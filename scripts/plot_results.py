@@ -14,6 +14,7 @@ def read_csv(filepath):
             results.append({
                 'workload':            row['workload'],
                 'policy':              row['policy'],
+                'backend':             row.get('backend', 'MapLevels'),
                 'threads':             int(row['threads']),
                 'throughput_ops_per_sec': int(row['throughput_ops_per_sec']),
                 'avg_latency_ns':      int(row['avg_latency_ns']),
@@ -25,15 +26,21 @@ def read_csv(filepath):
 # 데이터 그룹핑
 # ============================================================
 def group_data(results, metric):
-    """workload → policy → (threads_list, metric_list)"""
+    """workload → (policy, backend) → (threads_list, metric_list)"""
     grouped = defaultdict(lambda: defaultdict(lambda: ([], [])))
     for r in results:
         wl = r['workload']
-        pl = r['policy']
+        pl = (r['policy'], r['backend'])
         grouped[wl][pl][0].append(r['threads'])
         grouped[wl][pl][1].append(r[metric])
     return grouped
 
+# Level storage backend → line style
+BACKEND_LINESTYLE = {
+    'MapLevels':  '-',
+    'TickLadder': '--',
+}
+
 # ============================================================
 # 그래프 1: Throughput vs Threads
 # ============================================================
@@ -49,19 +56,21 @@ def plot_throughput(results, output_dir):
     style = {
         'MutexPolicy':       {'color': '#e74c3c', 'marker': 's', 'label': 'mutex'},
         'SharedMutexPolicy': {'color': '#3498db', 'marker': 'o', 'label': 'shared_mutex'},
+        'SeqLockPolicy':     {'color': '#2ecc71', 'marker': '^', 'label': 'seqlock'},
     }
 
     for ax, wl in zip(axes, workloads):
-        for policy in ['MutexPolicy', 'SharedMutexPolicy']:
-            if policy not in grouped[wl]:
-                continue
-            threads, throughput = grouped[wl][policy]
+        for key in sorted(grouped[wl]):
+            policy, backend = key
+            threads, throughput = grouped[wl][key]
             pairs = sorted(zip(threads, throughput))
             xs, ys = zip(*pairs)
             ys_m = [v / 1_000_000 for v in ys]
             s = style[policy]
             ax.plot(xs, ys_m,
-                    marker=s['marker'], color=s['color'], label=s['label'],
+                    marker=s['marker'], color=s['color'],
+                    label=f"{s['label']} ({backend})",
+                    linestyle=BACKEND_LINESTYLE.get(backend, '-'),
                     linewidth=2, markersize=6)
 
         ax.set_title(wl.replace('_', ' ').title(), fontsize=12, fontweight='bold')
@@ -71,7 +80,7 @@ def plot_throughput(results, output_dir):
         ax.legend()
 
     axes[0].set_ylabel('Throughput (M ops/sec)')
-    fig.suptitle('Throughput: mutex vs shared_mutex', fontsize=14, fontweight='bold')
+    fig.suptitle('Throughput: mutex vs shared_mutex vs seqlock', fontsize=14, fontweight='bold')
     plt.tight_layout()
 
     output_path = os.path.join(output_dir, 'throughput_comparison.png')
@@ -94,19 +103,21 @@ def plot_p99_latency(results, output_dir):
     style = {
         'MutexPolicy':       {'color': '#e74c3c', 'marker': 's', 'label': 'mutex'},
         'SharedMutexPolicy': {'color': '#3498db', 'marker': 'o', 'label': 'shared_mutex'},
+        'SeqLockPolicy':     {'color': '#2ecc71', 'marker': '^', 'label': 'seqlock'},
     }
 
     for ax, wl in zip(axes, workloads):
-        for policy in ['MutexPolicy', 'SharedMutexPolicy']:
-            if policy not in grouped[wl]:
-                continue
-            threads, p99 = grouped[wl][policy]
+        for key in sorted(grouped[wl]):
+            policy, backend = key
+            threads, p99 = grouped[wl][key]
             pairs = sorted(zip(threads, p99))
             xs, ys = zip(*pairs)
             ys_us = [v / 1000 for v in ys]
             s = style[policy]
             ax.plot(xs, ys_us,
-                    marker=s['marker'], color=s['color'], label=s['label'],
+                    marker=s['marker'], color=s['color'],
+                    label=f"{s['label']} ({backend})",
+                    linestyle=BACKEND_LINESTYLE.get(backend, '-'),
                     linewidth=2, markersize=6)
 
         ax.set_title(wl.replace('_', ' ').title(), fontsize=12, fontweight='bold')
@@ -116,7 +127,7 @@ def plot_p99_latency(results, output_dir):
         ax.legend()
 
     axes[0].set_ylabel('p99 Latency (μs)')
-    fig.suptitle('p99 Latency: mutex vs shared_mutex', fontsize=14, fontweight='bold')
+    fig.suptitle('p99 Latency: mutex vs shared_mutex vs seqlock', fontsize=14, fontweight='bold')
     plt.tight_layout()
 
     output_path = os.path.join(output_dir, 'p99_latency_comparison.png')
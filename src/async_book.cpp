@@ -0,0 +1,127 @@
+#include "async_book.h"
+#include "thread_placement.h"
+
+template <typename LP, typename LV>
+AsyncBook<LP, LV>::AsyncBook(Book& book, const AsyncConfig& cfg) : book_(book), cfg_(cfg) {
+    if (cfg_.num_clients == 0) cfg_.num_clients = 1;
+    if (cfg_.max_batch == 0) cfg_.max_batch = 1;
+    for (size_t c = 0; c < cfg_.num_clients; ++c)
+        clients_.push_back(std::make_unique<Client>(cfg_.queue_capacity));
+    thread_ = std::thread(&AsyncBook::run, this);
+}
+
+template <typename LP, typename LV>
+AsyncBook<LP, LV>::~AsyncBook() {
+    stop();
+}
+
+// === Client side ===
+
+template <typename LP, typename LV>
+bool AsyncBook<LP, LV>::try_submit(size_t client, const BookCommand& cmd, AsyncOp* op) {
+    if (op)
+        op->done_.store(false, std::memory_order_relaxed);   // published by the push
+    Client& c = *clients_[client];
+    if (!c.queue.try_push(Request{cmd, op}))
+        return false;
+    c.pushed.fetch_add(1, std::memory_order_release);
+    parker_.notify();
+    return true;
+}
+
+template <typename LP, typename LV>
+void AsyncBook<LP, LV>::submit(size_t client, const BookCommand& cmd, AsyncOp* op) {
+    while (!try_submit(client, cmd, op))
+        std::this_thread::yield();
+}
+
+template <typename LP, typename LV>
+void AsyncBook<LP, LV>::flush() {
+    uint64_t target = 0;
+    for (auto& c : clients_)
+        target += c->pushed.load(std::memory_order_acquire);
+    while (processed_.load(std::memory_order_acquire) < target)
+        std::this_thread::yield();
+}
+
+template <typename LP, typename LV>
+void AsyncBook<LP, LV>::stop() {
+    running_.store(false, std::memory_order_release);
+    parker_.wake();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+// === Drain thread ===
+
+template <typename LP, typename LV>
+void AsyncBook<LP, LV>::run() {
+    pin_current_thread(cfg_.cpu);
+
+    std::vector<BookCommand> cmds(cfg_.max_batch);
+    std::vector<AsyncOp*>    ops(cfg_.max_batch);
+    std::vector<BookResult>  results(cfg_.max_batch);
+    size_t first = 0;   // client polled first; rotates so none starves the rest
+    size_t idle_polls = 0;
+    Request r;
+
+    auto has_work = [this] {
+        if (!running_.load(std::memory_order_acquire))
+            return true;
+        for (auto& c : clients_)
+            if (!c->queue.empty()) return true;
+        return false;
+    };
+
+    for (;;) {
+        size_t n = 0;
+        for (size_t k = 0; k < clients_.size() && n < cfg_.max_batch; ++k) {
+            SpscQueue<Request>& queue = clients_[(first + k) % clients_.size()]->queue;
+            while (n < cfg_.max_batch && queue.try_pop(r)) {
+                cmds[n] = r.cmd;
+                ops[n] = r.op;
+                ++n;
+            }
+        }
+        first = (first + 1) % clients_.size();
+
+        if (n == 0) {
+            // Clients are done once running_ drops; exit after the last drain
+            if (!running_.load(std::memory_order_acquire)) {
+                bool drained = true;
+                for (auto& c : clients_)
+                    drained = drained && c->queue.empty();
+                if (drained) break;
+            }
+            // Poll for a while, then sleep until a client submits
+            if (++idle_polls < cfg_.idle_spins) {
+                std::this_thread::yield();
+            } else {
+                parker_.park(has_work);
+                idle_polls = 0;
+            }
+            continue;
+        }
+        idle_polls = 0;
+
+        book_.apply_batch(cmds.data(), n, results.data());
+        for (size_t i = 0; i < n; ++i) {
+            if (!ops[i]) continue;
+            ops[i]->result_ = results[i];
+            ops[i]->done_.store(true, std::memory_order_release);
+        }
+        batches_.store(batches_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        processed_.store(processed_.load(std::memory_order_relaxed) + n,
+                         std::memory_order_release);
+    }
+}
+
+// === Explicit Instantiation ===
+template class AsyncBook<MutexPolicy, MapLevels>;
+template class AsyncBook<MutexPolicy, TickLadder>;
+template class AsyncBook<SharedMutexPolicy, MapLevels>;
+template class AsyncBook<SharedMutexPolicy, TickLadder>;
+template class AsyncBook<SeqLockPolicy, MapLevels>;
+template class AsyncBook<SeqLockPolicy, TickLadder>;
+template class AsyncBook<SpinLockPolicy, MapLevels>;
+template class AsyncBook<SpinLockPolicy, TickLadder>;
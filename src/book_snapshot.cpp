@@ -0,0 +1,66 @@
+#include "book_snapshot.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'B', 'S', 'N', 'A', 'P', 0, 0};
+
+[[noreturn]] void io_error(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+void BookSnapshot::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        io_error("cannot create snapshot", path);
+
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kSnapshotVersion;
+    h.record_size = sizeof(SnapshotOrder);
+    h.bid_orders = bid_orders;
+    h.ask_orders = orders.size() - bid_orders;
+    h.exec_seq = exec_seq;
+
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(orders.data()),
+              static_cast<std::streamsize>(orders.size() * sizeof(SnapshotOrder)));
+    if (!out.flush())
+        io_error("snapshot write failed", path);
+}
+
+BookSnapshot BookSnapshot::read(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        io_error("cannot open snapshot", path);
+
+    SnapshotHeader h{};
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)))
+        throw std::runtime_error("not a snapshot (too short): " + path);
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0)
+        throw std::runtime_error("not a snapshot (bad magic): " + path);
+    if (h.version != kSnapshotVersion || h.record_size != sizeof(SnapshotOrder))
+        throw std::runtime_error("unsupported snapshot version: " + path);
+
+    // Check the counts against the file before sizing anything by them
+    std::streamoff body = static_cast<std::streamoff>(sizeof(h));
+    in.seekg(0, std::ios::end);
+    uint64_t records = static_cast<uint64_t>(in.tellg() - body) / sizeof(SnapshotOrder);
+    in.seekg(body);
+    if (h.bid_orders > records || h.ask_orders > records - h.bid_orders)
+        throw std::runtime_error("truncated snapshot: " + path);
+
+    BookSnapshot s;
+    s.exec_seq = h.exec_seq;
+    s.bid_orders = static_cast<size_t>(h.bid_orders);
+    s.orders.resize(static_cast<size_t>(h.bid_orders + h.ask_orders));
+    if (!in.read(reinterpret_cast<char*>(s.orders.data()),
+                 static_cast<std::streamsize>(s.orders.size() * sizeof(SnapshotOrder))))
+        throw std::runtime_error("truncated snapshot: " + path);
+    return s;
+}
@@ -0,0 +1,57 @@
+#include "book_stats.h"
+#include <thread>
+
+double ticks_per_ns() {
+    static const double ratio = [] {
+        auto c0 = std::chrono::steady_clock::now();
+        uint64_t t0 = read_ticks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto c1 = std::chrono::steady_clock::now();
+        uint64_t t1 = read_ticks();
+        double ns = std::chrono::duration<double, std::nano>(c1 - c0).count();
+        return static_cast<double>(t1 - t0) / ns;
+    }();
+    return ratio;
+}
+
+std::atomic<uint32_t> HistogramStatsPolicy::claimed_{0};
+
+static_assert(HistogramStatsPolicy::kSlots <= 32, "slot claims fit in claimed_");
+
+// acquire/release on claimed_ orders a slot's previous owner's last writes
+// before the next owner's first plain load.
+HistogramStatsPolicy::SlotClaim::SlotClaim() : index(kSlots) {
+    uint32_t bits = claimed_.load(std::memory_order_relaxed);
+    for (;;) {
+        uint32_t free = ~bits & ((uint32_t{1} << kSlots) - 1);
+        if (free == 0)
+            return;
+        uint32_t bit = free & (~free + 1);
+        if (claimed_.compare_exchange_weak(bits, bits | bit, std::memory_order_acquire)) {
+            index = static_cast<size_t>(__builtin_ctz(bit));
+            return;
+        }
+    }
+}
+
+HistogramStatsPolicy::SlotClaim::~SlotClaim() {
+    if (index < kSlots)
+        claimed_.fetch_and(~(uint32_t{1} << index), std::memory_order_release);
+}
+
+BookStatsSnapshot HistogramStatsPolicy::snapshot() const {
+    BookStatsSnapshot out;
+    for (size_t i = 0; i <= kSlots; ++i) {
+        const Slot& s = slots_[i];
+        for (int op = 0; op < kBookOps; ++op) {
+            s.wait[op].add_to(out.wait[op]);
+            s.hold[op].add_to(out.hold[op]);
+        }
+        s.match.add_to(out.match);
+        s.cancel_depth.add_to(out.cancel_depth);
+        out.fills          += s.fills.load(std::memory_order_relaxed);
+        out.levels_created += s.levels_created.load(std::memory_order_relaxed);
+        out.levels_erased  += s.levels_erased.load(std::memory_order_relaxed);
+    }
+    return out;
+}
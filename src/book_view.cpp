@@ -0,0 +1,24 @@
+#include "book_view.h"
+#include <algorithm>
+
+double BookView::vwap(Side side, uint64_t qty, uint64_t* filled) const {
+    uint64_t taken = 0;
+    double notional = 0;
+    for (const ViewLevel& l : levels(side)) {
+        if (taken == qty) break;
+        uint64_t q = std::min(l.quantity, qty - taken);
+        notional += static_cast<double>(q) * static_cast<double>(l.price);
+        taken += q;
+    }
+    if (filled) *filled = taken;
+    return taken ? notional / static_cast<double>(taken) : 0.0;
+}
+
+uint64_t BookView::quantity_through(Side side, uint64_t price) const {
+    uint64_t total = 0;
+    for (const ViewLevel& l : levels(side)) {
+        if (side == Side::BUY ? l.price < price : l.price > price) break;
+        total += l.quantity;
+    }
+    return total;
+}
@@ -0,0 +1,63 @@
+#include "book_views.h"
+
+template <typename LP, typename LV>
+BookViews<LP, LV>::BookViews(const Book& book, const ViewConfig& cfg)
+    : book_(book), cfg_(cfg), epochs_(cfg.max_readers)
+{
+    publish();
+}
+
+template <typename LP, typename LV>
+uint64_t BookViews<LP, LV>::publish() {
+    reclaim();
+    BookView* v;
+    if (free_.empty()) {
+        owned_.push_back(std::make_unique<BookView>());
+        v = owned_.back().get();
+    } else {
+        v = free_.back();
+        free_.pop_back();
+    }
+    book_.view(*v, cfg_.max_levels);
+
+    // Swap first, then advance: a reader entering after the advance can
+    // only load the new view, so the old one is safe to reuse once every
+    // reader is past the epoch it was retired in.
+    BookView* old = current_.exchange(v, std::memory_order_seq_cst);
+    uint64_t epoch = epochs_.advance();
+    if (old)
+        retired_.push_back(Retired{epoch, old});
+    published_.store(published_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return v->seq;
+}
+
+template <typename LP, typename LV>
+typename BookViews<LP, LV>::Guard BookViews<LP, LV>::read(size_t reader) const {
+    epochs_.enter(reader);
+    return Guard(&epochs_, reader, current_.load(std::memory_order_seq_cst));
+}
+
+template <typename LP, typename LV>
+size_t BookViews<LP, LV>::reclaim() {
+    if (retired_.empty()) return 0;
+    uint64_t oldest = epochs_.oldest();
+    size_t n = 0;
+    while (!retired_.empty() && retired_.front().epoch < oldest) {
+        free_.push_back(retired_.front().view);
+        retired_.pop_front();
+        ++n;
+    }
+    return n;
+}
+
+// === Explicit Instantiation ===
+template class BookViews<MutexPolicy, MapLevels>;
+template class BookViews<MutexPolicy, TickLadder>;
+template class BookViews<SharedMutexPolicy, MapLevels>;
+template class BookViews<SharedMutexPolicy, TickLadder>;
+template class BookViews<SeqLockPolicy, MapLevels>;
+template class BookViews<SeqLockPolicy, TickLadder>;
+template class BookViews<SpinLockPolicy, MapLevels>;
+template class BookViews<SpinLockPolicy, TickLadder>;
+template class BookViews<NullLockPolicy, MapLevels>;
+template class BookViews<NullLockPolicy, TickLadder>;
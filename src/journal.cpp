@@ -0,0 +1,240 @@
+#include "journal.h"
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ORDERBOOK_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'B', 'J', 'R', 'N', 'L', 0, 0};
+
+[[noreturn]] void io_error(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+// === JournalWriter ===
+
+JournalWriter::JournalWriter(const std::string& path, const Options& opts)
+    : opts_(opts), path_(path) {
+#ifdef ORDERBOOK_POSIX_IO
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+        io_error("cannot create journal", path);
+#else
+    (void)path;
+    throw std::runtime_error("JournalWriter needs POSIX I/O");
+#endif
+
+    JournalHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kJournalVersion;
+    h.record_size = sizeof(JournalRecord);
+    try {
+        write_all(&h, sizeof(h));
+    } catch (...) {
+#ifdef ORDERBOOK_POSIX_IO
+        ::close(fd_);
+#endif
+        throw;
+    }
+
+    active_.reserve(opts_.buffer_records);
+    spare_.reserve(opts_.buffer_records);
+    flusher_ = std::thread(&JournalWriter::run_flusher, this);
+}
+
+JournalWriter::~JournalWriter() {
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Nowhere to report it from a destructor; call flush() first to see it
+    }
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    work_cv_.notify_one();
+    flusher_.join();
+#ifdef ORDERBOOK_POSIX_IO
+    ::close(fd_);
+#endif
+}
+
+void JournalWriter::append(const JournalRecord& r) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (error_)
+        std::rethrow_exception(error_);
+
+    if (active_.size() == opts_.buffer_records) {
+        // Both buffers full: the only case where the appender waits on I/O
+        done_cv_.wait(lk, [this] { return !spare_full_ || error_; });
+        if (error_)
+            std::rethrow_exception(error_);
+        active_.swap(spare_);
+        spare_full_ = true;
+        work_cv_.notify_one();
+    }
+
+    active_.push_back(r);
+    ++appended_;
+}
+
+void JournalWriter::flush() {
+    std::unique_lock<std::mutex> lk(mu_);
+    uint64_t target = appended_;
+    if (flush_target_ < target)
+        flush_target_ = target;
+    work_cv_.notify_one();
+    done_cv_.wait(lk, [&] { return written_ >= target || error_; });
+    if (error_)
+        std::rethrow_exception(error_);
+}
+
+uint64_t JournalWriter::records_written() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return written_;
+}
+
+void JournalWriter::run_flusher() {
+    std::unique_lock<std::mutex> lk(mu_);
+
+    for (;;) {
+        work_cv_.wait_for(lk, opts_.commit_interval, [this] {
+            return stop_ || spare_full_ || written_ < flush_target_;
+        });
+
+        // Group commit: take whatever has accumulated since the last write
+        if (!spare_full_ && !active_.empty()) {
+            active_.swap(spare_);
+            spare_full_ = true;
+        }
+
+        if (spare_full_) {
+            size_t n = spare_.size();
+            lk.unlock();
+            std::exception_ptr err;
+            try {
+                write_all(spare_.data(), n * sizeof(JournalRecord));
+#ifdef ORDERBOOK_POSIX_IO
+                if (opts_.sync && ::fdatasync(fd_) != 0)
+                    io_error("journal sync failed", path_);
+#endif
+            } catch (...) {
+                err = std::current_exception();
+            }
+            lk.lock();
+            if (err) {
+                // Stop here: append() and flush() rethrow it on their own threads
+                error_ = err;
+                done_cv_.notify_all();
+                break;
+            }
+            spare_.clear();
+            spare_full_ = false;
+            written_ += n;
+            done_cv_.notify_all();
+            continue;
+        }
+
+        if (stop_)
+            break;
+    }
+}
+
+void JournalWriter::write_all(const void* data, size_t bytes) {
+#ifdef ORDERBOOK_POSIX_IO
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t n = ::write(fd_, p, bytes);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            io_error("journal write failed", path_);
+        }
+        p += n;
+        bytes -= static_cast<size_t>(n);
+    }
+#else
+    (void)data;
+    (void)bytes;
+#endif
+}
+
+// === JournalReader ===
+
+JournalReader::JournalReader(const std::string& path) {
+    const char* base = nullptr;
+    size_t bytes = 0;
+    void* map = nullptr;
+
+#ifdef ORDERBOOK_POSIX_IO
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        io_error("cannot open journal", path);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        io_error("cannot stat journal", path);
+    }
+    bytes = static_cast<size_t>(st.st_size);
+
+    if (bytes > 0) {
+        map = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            io_error("cannot mmap journal", path);
+        }
+        ::madvise(map, bytes, MADV_SEQUENTIAL);
+        base = static_cast<const char*>(map);
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        io_error("cannot open journal", path);
+    fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    base = fallback_.data();
+    bytes = fallback_.size();
+#endif
+
+    // The destructor won't run if we throw, so unmap here
+    auto reject = [&](const char* why) {
+#ifdef ORDERBOOK_POSIX_IO
+        if (map)
+            ::munmap(map, bytes);
+#endif
+        throw std::runtime_error(std::string(why) + ": " + path);
+    };
+
+    JournalHeader h{};
+    if (bytes < sizeof(h))
+        reject("not a journal (too short)");
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0)
+        reject("not a journal (bad magic)");
+    if (h.version != kJournalVersion || h.record_size != sizeof(JournalRecord))
+        reject("unsupported journal version");
+
+    map_ = map;
+    map_bytes_ = map ? bytes : 0;
+    records_ = reinterpret_cast<const JournalRecord*>(base + sizeof(h));
+    count_ = (bytes - sizeof(h)) / sizeof(JournalRecord);
+}
+
+JournalReader::~JournalReader() {
+#ifdef ORDERBOOK_POSIX_IO
+    if (map_)
+        ::munmap(map_, map_bytes_);
+#endif
+}
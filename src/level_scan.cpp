@@ -0,0 +1,104 @@
+#include "level_scan.h"
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define LEVEL_SCAN_X86 1
+#endif
+
+namespace {
+
+// Most FOK checks are covered by the first few levels; those are summed one
+// by one before any vector setup. After that the vector loops check the
+// running total once per kChunk levels.
+constexpr size_t kHead  = 8;
+constexpr size_t kChunk = 64;
+
+uint64_t sum_until_scalar(const uint64_t* q, size_t n, uint64_t enough) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += q[i];
+        if (total >= enough) break;
+    }
+    return total;
+}
+
+#ifdef LEVEL_SCAN_X86
+
+uint64_t sum_until_sse2(const uint64_t* q, size_t n, uint64_t enough) {
+    uint64_t total = 0;
+    size_t i = 0;
+    for (; i < n && i < kHead; ++i) {
+        total += q[i];
+        if (total >= enough) return total;
+    }
+    while (n - i >= 8) {
+        size_t end = i + std::min(kChunk, (n - i) & ~size_t{7});
+        __m128i a0 = _mm_setzero_si128(), a1 = a0, a2 = a0, a3 = a0;
+        for (; i < end; i += 8) {
+            a0 = _mm_add_epi64(a0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i)));
+            a1 = _mm_add_epi64(a1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i + 2)));
+            a2 = _mm_add_epi64(a2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i + 4)));
+            a3 = _mm_add_epi64(a3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i + 6)));
+        }
+        __m128i s = _mm_add_epi64(_mm_add_epi64(a0, a1), _mm_add_epi64(a2, a3));
+        s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+        total += static_cast<uint64_t>(_mm_cvtsi128_si64(s));
+        if (total >= enough) return total;
+    }
+    for (; i < n; ++i)
+        total += q[i];
+    return total;
+}
+
+__attribute__((target("avx2")))
+uint64_t sum_until_avx2(const uint64_t* q, size_t n, uint64_t enough) {
+    uint64_t total = 0;
+    size_t i = 0;
+    for (; i < n && i < kHead; ++i) {
+        total += q[i];
+        if (total >= enough) return total;
+    }
+    while (n - i >= 16) {
+        size_t end = i + std::min(kChunk, (n - i) & ~size_t{15});
+        __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+        for (; i < end; i += 16) {
+            a0 = _mm256_add_epi64(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i)));
+            a1 = _mm256_add_epi64(a1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i + 4)));
+            a2 = _mm256_add_epi64(a2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i + 8)));
+            a3 = _mm256_add_epi64(a3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i + 12)));
+        }
+        __m256i s = _mm256_add_epi64(_mm256_add_epi64(a0, a1), _mm256_add_epi64(a2, a3));
+        __m128i h = _mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+        h = _mm_add_epi64(h, _mm_unpackhi_epi64(h, h));
+        total += static_cast<uint64_t>(_mm_cvtsi128_si64(h));
+        if (total >= enough) return total;
+    }
+    for (; i < n; ++i)
+        total += q[i];
+    return total;
+}
+
+#endif  // LEVEL_SCAN_X86
+
+}  // namespace
+
+std::vector<LevelScanKernels> available_level_scan_kernels() {
+    std::vector<LevelScanKernels> out;
+#ifdef LEVEL_SCAN_X86
+    if (__builtin_cpu_supports("avx2"))
+        out.push_back({"avx2", sum_until_avx2});
+    out.push_back({"sse2", sum_until_sse2});
+#endif
+    out.push_back({"scalar", sum_until_scalar});
+    return out;
+}
+
+const LevelScanKernels& level_scan_kernels() {
+    static const LevelScanKernels best = available_level_scan_kernels().front();
+    return best;
+}
+
+uint64_t sum_until(const uint64_t* q, size_t n, uint64_t enough) {
+    return level_scan_kernels().sum_until(q, n, enough);
+}
@@ -0,0 +1,195 @@
+#include "matching_engine.h"
+
+namespace {
+
+constexpr int kDrainBatch = 64;   // commands taken from one queue before moving on
+
+}  // namespace
+
+template <typename LV>
+MatchingEngine<LV>::MatchingEngine(const EngineConfig& cfg) : cfg_(cfg) {
+    size_t num_shards = cfg_.num_shards ? cfg_.num_shards : 1;
+    shard_cpus_ = plan_threads(CpuTopology::detect(), cfg_.placement, num_shards);
+
+    shards_.reserve(num_shards);
+    for (size_t s = 0; s < num_shards; ++s) {
+        auto shard = std::make_unique<Shard>(cfg_.num_producers);
+        for (size_t p = 0; p < cfg_.num_producers; ++p)
+            shard->inbound.push_back(
+                std::make_unique<SpscQueue<EngineCommand>>(cfg_.queue_capacity));
+        shards_.push_back(std::move(shard));
+    }
+
+    // Known symbols get their books now, built on their shard's CPU so the
+    // memory lands where the shard thread will use it
+    for (uint32_t sym : cfg_.symbols) {
+        size_t s = shard_of(sym);
+        shards_[s]->books[sym] = run_on_cpu(shard_cpus_[s],
+                                            [&] { return std::make_unique<Book>(cfg_.book); });
+    }
+
+    for (size_t s = 0; s < num_shards; ++s)
+        shards_[s]->thread = std::thread(&MatchingEngine::run_shard, this, s);
+}
+
+template <typename LV>
+MatchingEngine<LV>::~MatchingEngine() {
+    stop();
+}
+
+// === Producer side ===
+
+template <typename LV>
+bool MatchingEngine<LV>::try_push(size_t producer, const EngineCommand& cmd) {
+    Shard& shard = *shards_[shard_of(cmd.symbol_id)];
+    if (!shard.inbound[producer]->try_push(cmd))
+        return false;
+    shard.pushed[producer].fetch_add(1, std::memory_order_release);
+    shard.parker.notify();
+    return true;
+}
+
+template <typename LV>
+bool MatchingEngine<LV>::try_add_order(size_t producer, const Order& order) {
+    EngineCommand cmd{EngineCommand::Kind::ADD, order.symbol_id, order.id, order};
+    return try_push(producer, cmd);
+}
+
+template <typename LV>
+bool MatchingEngine<LV>::try_cancel_order(size_t producer, uint32_t symbol_id,
+                                          uint64_t order_id) {
+    EngineCommand cmd{EngineCommand::Kind::CANCEL, symbol_id, order_id, Order{}};
+    return try_push(producer, cmd);
+}
+
+template <typename LV>
+void MatchingEngine<LV>::add_order(size_t producer, const Order& order) {
+    while (!try_add_order(producer, order))
+        std::this_thread::yield();
+}
+
+template <typename LV>
+void MatchingEngine<LV>::cancel_order(size_t producer, uint32_t symbol_id,
+                                      uint64_t order_id) {
+    while (!try_cancel_order(producer, symbol_id, order_id))
+        std::this_thread::yield();
+}
+
+template <typename LV>
+void MatchingEngine<LV>::flush() {
+    for (auto& shard : shards_) {
+        uint64_t target = 0;
+        for (auto& n : shard->pushed)
+            target += n.load(std::memory_order_acquire);
+        while (shard->processed.load(std::memory_order_acquire) < target)
+            std::this_thread::yield();
+    }
+}
+
+template <typename LV>
+void MatchingEngine<LV>::stop() {
+    running_.store(false, std::memory_order_release);
+    for (auto& shard : shards_) {
+        shard->parker.wake();
+        if (shard->thread.joinable())
+            shard->thread.join();
+    }
+}
+
+// === Queries ===
+
+template <typename LV>
+const typename MatchingEngine<LV>::Book* MatchingEngine<LV>::book(uint32_t symbol_id) const {
+    const auto& books = shards_[shard_of(symbol_id)]->books;
+    auto it = books.find(symbol_id);
+    return it == books.end() ? nullptr : it->second.get();
+}
+
+template <typename LV>
+ShardStats MatchingEngine<LV>::stats(size_t shard) const {
+    const Shard& s = *shards_[shard];
+    return ShardStats{s.processed.load(std::memory_order_acquire),
+                      s.rejected.load(std::memory_order_relaxed),
+                      s.fills.load(std::memory_order_relaxed)};
+}
+
+// === Shard thread ===
+
+template <typename LV>
+void MatchingEngine<LV>::run_shard(size_t index) {
+    // Books are created lazily on this thread, so after pinning they are
+    // first touched (and placed) on the shard's NUMA node
+    pin_current_thread(shard_cpus_[index]);
+
+    Shard& shard = *shards_[index];
+    ExecutionRing fills(1024);
+    EngineCommand cmd;
+    size_t idle_polls = 0;
+
+    auto has_work = [&] {
+        if (!running_.load(std::memory_order_acquire))
+            return true;
+        for (auto& queue : shard.inbound)
+            if (!queue->empty()) return true;
+        return false;
+    };
+
+    for (;;) {
+        bool idle = true;
+        for (auto& queue : shard.inbound) {
+            for (int n = 0; n < kDrainBatch && queue->try_pop(cmd); ++n) {
+                apply(shard, cmd, fills);
+                idle = false;
+            }
+        }
+
+        if (idle) {
+            // Producers are done once running_ drops; exit after the last drain
+            if (!running_.load(std::memory_order_acquire)) {
+                bool drained = true;
+                for (auto& queue : shard.inbound)
+                    drained = drained && queue->empty();
+                if (drained) break;
+            }
+            // Poll for a while, then sleep until a producer pushes
+            if (++idle_polls < cfg_.idle_spins) {
+                std::this_thread::yield();
+            } else {
+                shard.parker.park(has_work);
+                idle_polls = 0;
+            }
+        } else {
+            idle_polls = 0;
+        }
+    }
+}
+
+template <typename LV>
+void MatchingEngine<LV>::apply(Shard& shard, const EngineCommand& cmd,
+                               ExecutionRing& fills) {
+    bool ok;
+    if (cmd.kind == EngineCommand::Kind::ADD) {
+        auto& slot = shard.books[cmd.symbol_id];
+        if (!slot)
+            slot = std::make_unique<Book>(cfg_.book);
+        fills.clear();
+        ok = slot->add_order(cmd.order, &fills);
+        shard.fills.store(shard.fills.load(std::memory_order_relaxed)
+                          + fills.size() + fills.dropped(),
+                          std::memory_order_relaxed);
+    } else {
+        // A cancel can't succeed on a symbol with no book, so don't build one
+        auto it = shard.books.find(cmd.symbol_id);
+        ok = it != shard.books.end() && it->second->cancel_order(cmd.order_id);
+    }
+
+    if (!ok)
+        shard.rejected.store(shard.rejected.load(std::memory_order_relaxed) + 1,
+                             std::memory_order_relaxed);
+    shard.processed.store(shard.processed.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
+}
+
+// === Explicit Instantiation ===
+template class MatchingEngine<MapLevels>;
+template class MatchingEngine<TickLadder>;
@@ -3,121 +3,808 @@
 
 // === Write operations ===
 
-template <typename LP>
-bool OrderBook<LP>::add_order(const Order& order) {
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::reserve(size_t max_orders, size_t max_levels) {
     typename LP::write_lock lk(mtx_);
+    pool_.reserve(max_orders);
+    orders_.reserve(max_orders);
+    if constexpr (kIdFilter)
+        grow_registry(max_orders);
+    bids_.reserve(max_levels);
+    asks_.reserve(max_levels);
+}
 
-    if (orders_.find(order.id) != orders_.end())
-        return false;
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::add_order(const Order& order, ExecutionRing* fills) {
+    if constexpr (kIdFilter)
+        if (registry_.surely_present(order.id))
+            return false;
 
-    if (order.type == OrderType::LIMIT)
-        add_limit_order(order);
-    else
-        match_market_order(order);
+    uint64_t t0 = stats_.now();
+    typename LP::write_lock lk(mtx_);
+    uint64_t t1 = stats_.now();
 
-    return true;
+    bool ok = add_order_locked(order, fills);
+    if (ok)
+        update_top();
+    stats_.on_op(BookOp::ADD, t0, t1, stats_.now());
+    return ok;
 }
 
-template <typename LP>
-bool OrderBook<LP>::cancel_order(uint64_t order_id) {
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::cancel_order(uint64_t order_id) {
+    if constexpr (kIdFilter)
+        if (registry_.surely_absent(order_id))
+            return false;
+
+    uint64_t t0 = stats_.now();
     typename LP::write_lock lk(mtx_);
+    uint64_t t1 = stats_.now();
 
-    auto it = orders_.find(order_id);
-    if (it == orders_.end())
-        return false;
+    bool ok = cancel_order_locked(order_id);
+    if (ok)
+        update_top();
+    stats_.on_op(BookOp::CANCEL, t0, t1, stats_.now());
+    return ok;
+}
 
-    Order* order_ptr = it->second;
-    uint64_t price = order_ptr->price;
-    auto& levels = (order_ptr->side == Side::BUY) ? bids_ : asks_;
-    auto& level_orders = levels[price];
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::modify_order(uint64_t order_id, uint64_t new_price,
+                                         uint64_t new_qty, ExecutionRing* fills) {
+    if constexpr (kIdFilter)
+        if (registry_.surely_absent(order_id))
+            return false;
 
-    level_orders.remove_if([order_id](const Order& o) {
-        return o.id == order_id;
-    });
+    uint64_t t0 = stats_.now();
+    typename LP::write_lock lk(mtx_);
+    uint64_t t1 = stats_.now();
 
-    if (level_orders.empty())
-        levels.erase(price);
+    bool ok = modify_order_locked(order_id, new_price, new_qty, fills);
+    if (ok)
+        update_top();
+    stats_.on_op(BookOp::MODIFY, t0, t1, stats_.now());
+    return ok;
+}
 
-    orders_.erase(it);
-    return true;
+template <typename LP, typename LV, typename SP>
+size_t OrderBook<LP, LV, SP>::add_orders(const Order* orders, size_t count,
+                                         bool* status, ExecutionRing* fills) {
+    uint64_t t0 = stats_.now();
+    typename LP::write_lock lk(mtx_);
+    uint64_t t1 = stats_.now();
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = add_order_locked(orders[i], fills);
+        accepted += status[i];
+    }
+
+    update_top();
+    stats_.on_op(BookOp::BATCH, t0, t1, stats_.now());
+    return accepted;
+}
+
+template <typename LP, typename LV, typename SP>
+size_t OrderBook<LP, LV, SP>::cancel_orders(const uint64_t* order_ids, size_t count,
+                                            bool* status) {
+    uint64_t t0 = stats_.now();
+    typename LP::write_lock lk(mtx_);
+    uint64_t t1 = stats_.now();
+
+    size_t cancelled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = cancel_order_locked(order_ids[i]);
+        cancelled += status[i];
+    }
+
+    update_top();
+    stats_.on_op(BookOp::BATCH, t0, t1, stats_.now());
+    return cancelled;
+}
+
+template <typename LP, typename LV, typename SP>
+size_t OrderBook<LP, LV, SP>::apply_batch(const BookCommand* cmds, size_t count,
+                                          BookResult* results, ExecutionRing* fills) {
+    uint64_t t0 = stats_.now();
+    typename LP::write_lock lk(mtx_);
+    uint64_t t1 = stats_.now();
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const BookCommand& c = cmds[i];
+        uint64_t seq = exec_seq_, qty = traded_qty_;
+        bool ok;
+        switch (c.kind) {
+            case BookCommand::Kind::ADD:
+                ok = add_order_locked(c.order, fills);
+                break;
+            case BookCommand::Kind::CANCEL:
+                ok = cancel_order_locked(c.order.id);
+                break;
+            default:
+                ok = modify_order_locked(c.order.id, c.order.price, c.order.quantity, fills);
+                break;
+        }
+        results[i] = BookResult{ok, static_cast<uint32_t>(exec_seq_ - seq), traded_qty_ - qty};
+        accepted += ok;
+    }
+
+    update_top();
+    stats_.on_op(BookOp::BATCH, t0, t1, stats_.now());
+    return accepted;
 }
 
 // === Read operations ===
 
-template <typename LP>
-std::optional<uint64_t> OrderBook<LP>::best_bid_price() const {
+template <typename LP, typename LV, typename SP>
+std::optional<uint64_t> OrderBook<LP, LV, SP>::best_bid_price() const {
+    if constexpr (kSeqlockTop) {
+        TopOfBook t = top_.read();
+        if (!t.has_bid()) return std::nullopt;
+        return t.bid_price;
+    } else {
+        typename LP::read_lock lk(mtx_);
+        return bids_.best_price();
+    }
+}
+
+template <typename LP, typename LV, typename SP>
+std::optional<uint64_t> OrderBook<LP, LV, SP>::best_ask_price() const {
+    if constexpr (kSeqlockTop) {
+        TopOfBook t = top_.read();
+        if (!t.has_ask()) return std::nullopt;
+        return t.ask_price;
+    } else {
+        typename LP::read_lock lk(mtx_);
+        return asks_.best_price();
+    }
+}
+
+template <typename LP, typename LV, typename SP>
+TopOfBook OrderBook<LP, LV, SP>::top_of_book() const {
+    if constexpr (kSeqlockTop) {
+        return top_.read();
+    } else {
+        typename LP::read_lock lk(mtx_);
+        return published_;
+    }
+}
+
+template <typename LP, typename LV, typename SP>
+BookDepth OrderBook<LP, LV, SP>::depth(size_t n) const {
+    BookDepth d;
     typename LP::read_lock lk(mtx_);
-    if (bids_.empty()) return std::nullopt;
-    return bids_.rbegin()->first;
+    d.bids.reserve(std::min(n, bids_.size()));
+    d.asks.reserve(std::min(n, asks_.size()));
+    auto collect = [](std::vector<LevelInfo>& out) {
+        return [&out](uint64_t price, const PriceLevel& level) {
+            out.push_back(LevelInfo{price, level.quantity, level.count});
+        };
+    };
+    bids_.for_each_from_best(n, collect(d.bids));
+    asks_.for_each_from_best(n, collect(d.asks));
+    d.seq = delta_seq_;
+    return d;
 }
 
-template <typename LP>
-std::optional<uint64_t> OrderBook<LP>::best_ask_price() const {
+template <typename LP, typename LV, typename SP>
+uint64_t OrderBook<LP, LV, SP>::quantity_through(Side side, uint64_t price) const {
     typename LP::read_lock lk(mtx_);
-    if (asks_.empty()) return std::nullopt;
-    return asks_.begin()->first;
+    return side == Side::BUY ? bids_.quantity_through(price, UINT64_MAX)
+                             : asks_.quantity_through(price, UINT64_MAX);
 }
 
-template <typename LP>
-size_t OrderBook<LP>::total_orders() const {
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::set_delta_feed(SpscQueue<LevelDelta>* feed) {
+    typename LP::write_lock lk(mtx_);
+    delta_feed_ = feed;
+}
+
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::set_journal(JournalWriter* journal) {
+    typename LP::write_lock lk(mtx_);
+    journal_ = journal;
+}
+
+// === Snapshot / load ===
+
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::snapshot(BookSnapshot& out) const {
+    for (;;) {
+        size_t need;
+        {
+            typename LP::read_lock lk(mtx_);
+            need = orders_.size();
+            if (out.orders.capacity() >= need) {
+                out.orders.clear();
+                auto copy = [&out, this](uint64_t price, const PriceLevel& level) {
+                    for (const OrderNode* n = level.head; n; n = n->next) {
+                        const OrderCold& c = pool_.cold(n);
+                        out.orders.push_back(SnapshotOrder{n->id, price, c.symbol_id,
+                                                           n->remaining, c.peak, c.reserve});
+                    }
+                };
+                bids_.for_each_from_best(SIZE_MAX, copy);
+                out.bid_orders = out.orders.size();
+                asks_.for_each_from_best(SIZE_MAX, copy);
+                out.exec_seq = exec_seq_;
+                return;
+            }
+        }
+        out.orders.reserve(need + need / 8);   // headroom for adds in between
+    }
+}
+
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::view(BookView& out, size_t max_levels) const {
+    for (;;) {
+        size_t need_orders, need_bids, need_asks;
+        {
+            typename LP::read_lock lk(mtx_);
+            need_orders = orders_.size();
+            need_bids = std::min(bids_.size(), max_levels);
+            need_asks = std::min(asks_.size(), max_levels);
+            if (out.orders.capacity() >= need_orders && out.bids.capacity() >= need_bids
+                && out.asks.capacity() >= need_asks) {
+                out.orders.clear();
+                auto copy = [&out, this](std::vector<ViewLevel>& levels) {
+                    levels.clear();
+                    return [&out, &levels, this](uint64_t price, const PriceLevel& level) {
+                        levels.push_back(ViewLevel{price, level.quantity, level.count,
+                                                   static_cast<uint32_t>(out.orders.size())});
+                        for (const OrderNode* n = level.head; n; n = n->next)
+                            out.orders.push_back(ViewOrder{n->id, n->remaining, pool_.cold(n).reserve});
+                    };
+                };
+                bids_.for_each_from_best(max_levels, copy(out.bids));
+                asks_.for_each_from_best(max_levels, copy(out.asks));
+                out.seq = delta_seq_;
+                out.exec_seq = exec_seq_;
+                return;
+            }
+        }
+        out.orders.reserve(need_orders + need_orders / 8);
+        out.bids.reserve(need_bids + need_bids / 8);
+        out.asks.reserve(need_asks + need_asks / 8);
+    }
+}
+
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::load(const BookSnapshot& snap) {
+    typename LP::write_lock lk(mtx_);
+    size_t bid_levels = 0, ask_levels = 0;
+    if (!orders_.empty() || !snapshot_fits(snap, bid_levels, ask_levels))
+        return false;
+
+    size_t n = snap.orders.size();
+    pool_.reserve(n);
+    orders_.reserve(n);
+    if constexpr (kIdFilter)
+        grow_registry(n);
+    bids_.reserve(bid_levels);
+    asks_.reserve(ask_levels);
+
+    if (!load_side<Side::BUY>(snap.bids_begin(), snap.bids_end()) ||
+        !load_side<Side::SELL>(snap.asks_begin(), snap.asks_end())) {
+        clear_locked();
+        return false;
+    }
+
+    exec_seq_ = snap.exec_seq;
+    bids_.for_each_from_best(SIZE_MAX, [this](uint64_t price, const PriceLevel& level) {
+        level_changed<Side::BUY>(price, level);
+    });
+    asks_.for_each_from_best(SIZE_MAX, [this](uint64_t price, const PriceLevel& level) {
+        level_changed<Side::SELL>(price, level);
+    });
+    update_top();
+    return true;
+}
+
+template <typename LP, typename LV, typename SP>
+uint64_t OrderBook<LP, LV, SP>::dropped_deltas() const {
+    typename LP::read_lock lk(mtx_);
+    return deltas_dropped_;
+}
+
+template <typename LP, typename LV, typename SP>
+size_t OrderBook<LP, LV, SP>::total_orders() const {
     typename LP::read_lock lk(mtx_);
     return orders_.size();
 }
 
-template <typename LP>
-size_t OrderBook<LP>::total_bid_levels() const {
+template <typename LP, typename LV, typename SP>
+size_t OrderBook<LP, LV, SP>::total_bid_levels() const {
     typename LP::read_lock lk(mtx_);
     return bids_.size();
 }
 
-template <typename LP>
-size_t OrderBook<LP>::total_ask_levels() const {
+template <typename LP, typename LV, typename SP>
+size_t OrderBook<LP, LV, SP>::total_ask_levels() const {
     typename LP::read_lock lk(mtx_);
     return asks_.size();
 }
 
 // === Internal (lock already held) ===
 
-template <typename LP>
-void OrderBook<LP>::add_limit_order(const Order& order) {
-    auto& levels = (order.side == Side::BUY) ? bids_ : asks_;
-    auto& level_orders = levels[order.price];
-    level_orders.push_back(order);
-    orders_[order.id] = &level_orders.back();
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::add_order_locked(const Order& order, ExecutionRing* fills) {
+    if (orders_.find(order.id))
+        return false;
+    return order.side == Side::BUY ? add_side<Side::BUY>(order, fills)
+                                   : add_side<Side::SELL>(order, fills);
 }
 
-template <typename LP>
-void OrderBook<LP>::match_market_order(Order order) {
-    auto& levels = (order.side == Side::BUY) ? asks_ : bids_;
+template <typename LP, typename LV, typename SP>
+template <Side S>
+bool OrderBook<LP, LV, SP>::add_side(const Order& order, ExecutionRing* fills) {
+    bool is_limit = order.type == OrderType::LIMIT;
+    bool may_rest = is_limit && order.tif == TimeInForce::GTC;
+
+    if (is_limit) {
+        if (!levels<S>().accepts(order.price))
+            return false;
+        if (may_rest && order.quantity > kMaxRestingQuantity)
+            return false;
+    }
+
+    // Post-only and FOK are decided up front against the opposite side, so
+    // a rejected order leaves no trace (no fills, no journal record).
+    if (order.post_only && (!is_limit || crosses<S>(order)))
+        return false;
+    if (order.tif == TimeInForce::FOK && fillable_quantity<S>(order) < order.quantity)
+        return false;
+
+    if (journal_)
+        journal_->append(make_add_record(order));
+
+    Order taker = order;
+    match_order<S>(taker, fills);
+    if (may_rest && taker.remaining > 0)
+        add_limit_order<S>(taker);
+
+    return true;
+}
 
-    while (order.remaining > 0 && !levels.empty()) {
-        auto it = levels.begin();
-        auto& level_orders = it->second;
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::cancel_order_locked(uint64_t order_id) {
+    // Journal first: if append() throws, the book is left untouched
+    if (journal_) {
+        OrderNode* live = orders_.find(order_id);
+        if (!live)
+            return false;
+        journal_->append(make_cancel_record(pool_.cold(live).symbol_id, order_id));
+    }
 
-        for (auto& resting : level_orders) {
-            if (order.remaining == 0) break;
-            if (resting.remaining == 0) continue;
+    OrderNode* node = unindex_order(order_id);
+    if (!node)
+        return false;
 
-            uint64_t exec_qty = std::min(order.remaining, resting.remaining);
-            execute_trade(order, resting, exec_qty);
+    const OrderCold& cold = pool_.cold(node);
+    stats_.on_cancel(cold.level->count);
+    if (cold.side() == Side::BUY)
+        remove_node<Side::BUY>(node);
+    else
+        remove_node<Side::SELL>(node);
+    return true;
+}
+
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::modify_order_locked(uint64_t order_id, uint64_t new_price,
+                                                uint64_t new_qty, ExecutionRing* fills) {
+    OrderNode* node = orders_.find(order_id);
+    if (!node || new_qty == 0 || new_qty > kMaxRestingQuantity)
+        return false;
+
+    return pool_.cold(node).side() == Side::BUY
+        ? modify_side<Side::BUY>(node, new_price, new_qty, fills)
+        : modify_side<Side::SELL>(node, new_price, new_qty, fills);
+}
+
+template <typename LP, typename LV, typename SP>
+template <Side S>
+bool OrderBook<LP, LV, SP>::modify_side(OrderNode* node, uint64_t new_price, uint64_t new_qty,
+                                        ExecutionRing* fills) {
+    auto& levels = this->levels<S>();
+    if (!levels.accepts(new_price))
+        return false;
+
+    OrderCold& cold = pool_.cold(node);
+    uint64_t order_id = node->id;
+
+    if (journal_)
+        journal_->append(make_modify_record(cold.symbol_id, order_id, new_price, new_qty));
+
+    uint64_t old_price = cold.price;
+    PriceLevel* level = cold.level;
+    uint32_t qty = static_cast<uint32_t>(new_qty);
+
+    // Size down: in place, keeps its spot in the FIFO
+    if (new_price == old_price && new_qty <= pool_.total_remaining(node)) {
+        level->quantity -= node->remaining;
+        pool_.reduce(node, qty);
+        level->quantity += node->remaining;
+        level_changed<S>(old_price, *level);
+        return true;
+    }
+
+    level->unlink(node);
+
+    // Size up at the same price: back of the same level
+    if (new_price == old_price) {
+        pool_.reset_quantity(node, qty);
+        level->push_back(node);
+        level_changed<S>(old_price, *level);
+        return true;
+    }
+
+    level_changed<S>(old_price, *level);
+    if (level->empty()) {
+        levels.erase(old_price);
+        hint_.level = nullptr;
+        stats_.on_level_erased();
+    }
+
+    // New price: cross first like an incoming order, then rest the remainder
+    Order taker = Order::Limit(order_id, cold.symbol_id, S, new_price, new_qty);
+    match_order<S>(taker, fills);
+    if (taker.remaining == 0) {
+        unindex_order(order_id);
+        pool_.release(node);
+        return true;
+    }
+
+    PriceLevel& dest = levels.level(new_price);
+    if (dest.empty())
+        stats_.on_level_created();
+    cold.price = new_price;
+    cold.level = &dest;
+    pool_.reset_quantity(node, static_cast<uint32_t>(taker.remaining));
+    dest.push_back(node);
+    level_changed<S>(new_price, dest);
+    return true;
+}
+
+// orders_ and registry_ always change together
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::index_order(uint64_t id, OrderNode* node) {
+    orders_.insert(id, node);
+    if constexpr (kIdFilter) {
+        if (registry_.full())
+            grow_registry(orders_.size() * 2);
+        registry_.insert(id);
+    }
+}
+
+template <typename LP, typename LV, typename SP>
+OrderNode* OrderBook<LP, LV, SP>::unindex_order(uint64_t id) {
+    OrderNode* node = orders_.extract(id);
+    if constexpr (kIdFilter)
+        if (node)
+            registry_.erase(id);
+    return node;
+}
+
+// Rebuild the registry from the orders linked into levels.
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::grow_registry(size_t capacity) {
+    registry_.rebuild(capacity, [this](auto&& add) {
+        auto add_level = [&](uint64_t, const PriceLevel& level) {
+            for (const OrderNode* n = level.head; n; n = n->next)
+                add(n->id);
+        };
+        bids_.for_each_from_best(SIZE_MAX, add_level);
+        asks_.for_each_from_best(SIZE_MAX, add_level);
+    });
+}
+
+// Everything load() checks before touching the book except repeated ids,
+// which the order index catches while loading. Also counts levels per side.
+template <typename LP, typename LV, typename SP>
+bool OrderBook<LP, LV, SP>::snapshot_fits(const BookSnapshot& snap, size_t& bid_levels,
+                                          size_t& ask_levels) const {
+    if (snap.bid_orders > snap.orders.size())
+        return false;
+
+    auto side_fits = [](const auto& levels, Side side, const SnapshotOrder* first,
+                        const SnapshotOrder* last, size_t& count) {
+        for (const SnapshotOrder* r = first; r != last; ++r) {
+            if (r->visible == 0 || uint64_t{r->visible} + r->reserve > kMaxRestingQuantity)
+                return false;
+            if (r->peak ? r->visible > r->peak : r->reserve > 0)
+                return false;
+            if (r == first || r->price != r[-1].price) {
+                if (!levels.accepts(r->price))
+                    return false;
+                if (r != first && (side == Side::BUY ? r->price > r[-1].price
+                                                     : r->price < r[-1].price))
+                    return false;
+                ++count;
+            }
+        }
+        return true;
+    };
+
+    if (!side_fits(bids_, Side::BUY, snap.bids_begin(), snap.bids_end(), bid_levels) ||
+        !side_fits(asks_, Side::SELL, snap.asks_begin(), snap.asks_end(), ask_levels))
+        return false;
+    return bid_levels == 0 || ask_levels == 0
+        || snap.bids_begin()->price < snap.asks_begin()->price;
+}
+
+// Append [first, last), already in priority order, to one side. False on a
+// repeated id; the caller clears what was loaded.
+template <typename LP, typename LV, typename SP>
+template <Side S>
+bool OrderBook<LP, LV, SP>::load_side(const SnapshotOrder* first, const SnapshotOrder* last) {
+    auto& levels = this->levels<S>();
+    // Ids come in price order, so their index and registry slots are
+    // scattered; fetch them a few orders ahead.
+    constexpr ptrdiff_t kAhead = 16;
+    PriceLevel* level = nullptr;
+    for (; first != last; ++first) {
+        if (last - first > kAhead) {
+            orders_.prefetch(first[kAhead].id);
+            if constexpr (kIdFilter)
+                registry_.prefetch(first[kAhead].id);
+        }
+        const SnapshotOrder& r = *first;
+        if (orders_.find(r.id))
+            return false;
+        if (!level || r.price != first[-1].price) {
+            level = &levels.level(r.price);
+            stats_.on_level_created();
+        }
+
+        OrderNode* node = pool_.acquire(Order::Limit(r.id, r.symbol_id, S, r.price, r.visible),
+                                        level);
+        if (r.peak) {
+            OrderCold& c = pool_.cold(node);
+            c.peak = r.peak;
+            c.reserve = r.reserve;
+            node->iceberg = r.reserve > 0;
         }
+        index_order(r.id, node);
+        level->push_back(node);
+    }
+    return true;
+}
+
+// Drop every resting order (load() rollback).
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::clear_locked() {
+    auto clear_side = [this](auto& side) {
+        while (PriceLevel* level = side.best()) {
+            for (OrderNode* n = level->head; n;) {
+                OrderNode* next = n->next;
+                unindex_order(n->id);
+                pool_.release(n);
+                n = next;
+            }
+            side.pop_best();
+            stats_.on_level_erased();
+        }
+    };
+    clear_side(bids_);
+    clear_side(asks_);
+    hint_.level = nullptr;
+}
+
+template <typename LP, typename LV, typename SP>
+template <Side S>
+void OrderBook<LP, LV, SP>::add_limit_order(const Order& order) {
+    if (!(hint_.level && hint_.side == S && hint_.price == order.price))
+        hint_ = LevelHint{S, order.price, &levels<S>().level(order.price)};
+
+    PriceLevel& level = *hint_.level;
+    if (level.empty())
+        stats_.on_level_created();
+    OrderNode* node = pool_.acquire(order, &level);
+    index_order(order.id, node);   // before linking: a registry rebuild must not see it yet
+    level.push_back(node);
+    level_changed<S>(order.price, level);
+}
+
+// Sweep the opposite side from its best price. Limit orders stop at the
+// first level that no longer crosses their price; market orders get the
+// side's worst price as their limit, so the loop has one test for both.
+template <typename LP, typename LV, typename SP>
+template <Side S>
+void OrderBook<LP, LV, SP>::match_order(Order& order, ExecutionRing* fills) {
+    constexpr Side R = PriceOrder<S>::opposite;   // resting side
+    auto& levels = this->levels<R>();
+    uint64_t limit = order.type == OrderType::LIMIT ? order.price : PriceOrder<R>::worst;
+    uint64_t t0 = stats_.now();
+    uint64_t start_qty = order.remaining;
+
+    while (order.remaining > 0) {
+        PriceLevel* best = levels.best();
+        if (!best) break;
+        uint64_t level_price = *levels.best_price();
+        if (!PriceOrder<R>::within(level_price, limit))
+            break;
 
-        level_orders.remove_if([](const Order& o) { return o.is_filled(); });
+        auto& level = *best;
 
-        if (level_orders.empty())
-            levels.erase(it);
+        if (order.remaining >= level.quantity) {
+            take_level(order, level, level_price, fills);
+        } else {
+            // Fill from the front of the FIFO; filled orders leave in the same pass
+            while (order.remaining > 0 && !level.empty()) {
+                OrderNode* resting = level.head;
+                uint64_t exec_qty = std::min<uint64_t>(order.remaining, resting->remaining);
+                execute_trade(order, *resting, level_price, exec_qty, fills);
+                level.quantity -= exec_qty;
+
+                if (resting->remaining == 0) {
+                    level.unlink(resting);
+                    if (resting->iceberg && pool_.replenish(resting)) {
+                        level.push_back(resting);   // refilled slice loses time priority
+                    } else {
+                        unindex_order(resting->id);
+                        pool_.release(resting);
+                    }
+                }
+            }
+        }
+
+        level_changed<R>(level_price, level);
+        if (level.empty()) {
+            levels.pop_best();
+            hint_.level = nullptr;
+            stats_.on_level_erased();
+        }
+    }
+
+    if (order.remaining != start_qty)
+        stats_.on_match(t0, stats_.now());
+}
+
+// The order covers every visible slice at this level: fill them front to
+// back and detach the whole queue at once instead of unlinking node by node
+// and keeping the level's totals in step. Refilled iceberg slices queue up
+// again behind, in the order they were reached, as the node-at-a-time loop
+// would leave them.
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::take_level(Order& order, PriceLevel& level, uint64_t price,
+                                       ExecutionRing* fills) {
+    OrderNode* node = level.head;
+    level.clear();
+    while (node) {
+        OrderNode* next = node->next;
+        if (next) {
+            orders_.prefetch(next->id);
+            if constexpr (kIdFilter)
+                registry_.prefetch(next->id);
+        }
+        execute_trade(order, *node, price, node->remaining, fills);
+        if (node->iceberg && pool_.replenish(node)) {
+            level.push_back(node);
+        } else {
+            unindex_order(node->id);
+            pool_.release(node);
+        }
+        node = next;
     }
 }
 
-template <typename LP>
-void OrderBook<LP>::execute_trade(Order& incoming, Order& resting, uint64_t qty) {
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::execute_trade(Order& incoming, OrderNode& resting, uint64_t price,
+                                          uint64_t qty, ExecutionRing* fills) {
     incoming.remaining -= qty;
-    resting.remaining -= qty;
+    resting.remaining -= static_cast<uint32_t>(qty);
 
-    if (resting.is_filled())
-        orders_.erase(resting.id);
+    stats_.on_fill();
+    traded_qty_ += qty;
+    uint64_t seq = ++exec_seq_;
+    if (fills)
+        fills->push(Execution{resting.id, incoming.id, price, qty, seq});
+}
+
+// Would a limit order trade on arrival?
+template <typename LP, typename LV, typename SP>
+template <Side S>
+bool OrderBook<LP, LV, SP>::crosses(const Order& order) const {
+    constexpr Side R = PriceOrder<S>::opposite;
+    auto best = levels<R>().best_price();
+    return best && PriceOrder<R>::within(*best, order.price);
+}
+
+// Visible quantity the order could take from the opposite side, within its
+// limit price. Stops as soon as the order's full size is covered. Hidden
+// iceberg reserves are not counted, so a FOK that passes always fills.
+template <typename LP, typename LV, typename SP>
+template <Side S>
+uint64_t OrderBook<LP, LV, SP>::fillable_quantity(const Order& order) const {
+    constexpr Side R = PriceOrder<S>::opposite;
+    uint64_t limit = order.type == OrderType::LIMIT ? order.price : PriceOrder<R>::worst;
+    return levels<R>().quantity_through(limit, order.quantity);
+}
+
+// Unlink a resting order in O(1) and drop its level if it was the last one.
+template <typename LP, typename LV, typename SP>
+template <Side S>
+void OrderBook<LP, LV, SP>::remove_node(OrderNode* node) {
+    const OrderCold& cold = pool_.cold(node);
+    PriceLevel* level = cold.level;
+    uint64_t price = cold.price;
+
+    level->unlink(node);
+    pool_.release(node);
+    level_changed<S>(price, *level);
+
+    if (level->empty()) {
+        levels<S>().erase(price);
+        hint_.level = nullptr;
+        stats_.on_level_erased();
+    }
+}
+
+// Recompute best bid/ask and publish if anything visible changed.
+template <typename LP, typename LV, typename SP>
+void OrderBook<LP, LV, SP>::update_top() {
+    const PriceLevel* bid = bids_.best();
+    const PriceLevel* ask = asks_.best();
+
+    TopOfBook t;
+    if (bid) {
+        t.bid_price = *bids_.best_price();
+        t.bid_qty   = bid->quantity;
+    }
+    if (ask) {
+        t.ask_price = *asks_.best_price();
+        t.ask_qty   = ask->quantity;
+    }
+
+    if (t.bid_price == published_.bid_price && t.bid_qty == published_.bid_qty &&
+        t.ask_price == published_.ask_price && t.ask_qty == published_.ask_qty)
+        return;
+
+    t.seq = published_.seq + 1;
+    published_ = t;
+    if constexpr (kSeqlockTop)
+        top_.publish(t);
+}
+
+// Every write that changes a level's quantity or count ends up here.
+template <typename LP, typename LV, typename SP>
+template <Side S>
+void OrderBook<LP, LV, SP>::level_changed(uint64_t price, const PriceLevel& level) {
+    levels<S>().set_quantity(price, level.quantity);
+    if (!delta_feed_) return;
+
+    LevelDelta d{++delta_seq_, price, level.quantity, level.count, S};
+    if (!delta_feed_->try_push(d))
+        ++deltas_dropped_;
 }
 
 // === Explicit Instantiation ===
-template class OrderBook<MutexPolicy>;
-template class OrderBook<SharedMutexPolicy>;
+template class OrderBook<MutexPolicy, MapLevels>;
+template class OrderBook<SharedMutexPolicy, MapLevels>;
+template class OrderBook<MutexPolicy, TickLadder>;
+template class OrderBook<SharedMutexPolicy, TickLadder>;
+template class OrderBook<SpinLockPolicy, MapLevels>;
+template class OrderBook<SpinLockPolicy, TickLadder>;
+template class OrderBook<TicketLockPolicy, MapLevels>;
+template class OrderBook<TicketLockPolicy, TickLadder>;
+template class OrderBook<AdaptiveLockPolicy, MapLevels>;
+template class OrderBook<AdaptiveLockPolicy, TickLadder>;
+template class OrderBook<SeqLockPolicy, MapLevels>;
+template class OrderBook<SeqLockPolicy, TickLadder>;
+template class OrderBook<NullLockPolicy, MapLevels>;
+template class OrderBook<NullLockPolicy, TickLadder>;
+
+template class OrderBook<MutexPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<SharedMutexPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<MutexPolicy, TickLadder, HistogramStatsPolicy>;
+template class OrderBook<SharedMutexPolicy, TickLadder, HistogramStatsPolicy>;
+template class OrderBook<SpinLockPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<SpinLockPolicy, TickLadder, HistogramStatsPolicy>;
+template class OrderBook<TicketLockPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<TicketLockPolicy, TickLadder, HistogramStatsPolicy>;
+template class OrderBook<AdaptiveLockPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<AdaptiveLockPolicy, TickLadder, HistogramStatsPolicy>;
+template class OrderBook<SeqLockPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<SeqLockPolicy, TickLadder, HistogramStatsPolicy>;
+template class OrderBook<NullLockPolicy, MapLevels, HistogramStatsPolicy>;
+template class OrderBook<NullLockPolicy, TickLadder, HistogramStatsPolicy>;
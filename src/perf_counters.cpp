@@ -0,0 +1,79 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+int open_event(uint64_t config, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group < 0;   // the leader starts and stops the group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+    const uint64_t events[4] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+                                PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < 4; ++i) {
+        fds_[i] = open_event(events[i], i == 0 ? -1 : fds_[0]);
+        if (fds_[i] < 0) {
+            for (int j = 0; j < i; ++j) close(fds_[j]);
+            for (int& fd : fds_) fd = -1;
+            return;
+        }
+    }
+    leader_ = fds_[0];
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_)
+        if (fd >= 0) close(fd);
+}
+
+void PerfCounters::start() {
+    if (available()) ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::stop() {
+    if (available()) ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::reset() {
+    if (available()) ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounts PerfCounters::read() const {
+    PerfCounts c;
+    uint64_t buf[5] = {};   // nr, then one value per event in open order
+    if (!available() || ::read(leader_, buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)))
+        return c;
+    c.instructions = buf[1];
+    c.cycles = buf[2];
+    c.branches = buf[3];
+    c.branch_misses = buf[4];
+    return c;
+}
+
+#else
+
+PerfCounters::PerfCounters() {}
+PerfCounters::~PerfCounters() {}
+void PerfCounters::start() {}
+void PerfCounters::stop() {}
+void PerfCounters::reset() {}
+PerfCounts PerfCounters::read() const { return {}; }
+
+#endif
@@ -0,0 +1,91 @@
+#include "price_levels.h"
+
+template <Side S>
+TickSide<S>::TickSide(const LadderConfig& cfg)
+    : cfg_(cfg),
+      levels_(cfg.num_levels),
+      qty_(cfg.num_levels, 0),
+      bitmap_((cfg.num_levels + 63) / 64, 0) {}
+
+template <Side S>
+PriceLevel& TickSide<S>::level(uint64_t price) {
+    size_t idx = index_of(price);
+    if (!occupied(idx)) {
+        bitmap_[idx >> 6] |= uint64_t{1} << (idx & 63);
+        ++count_;
+        if (best_ == npos || PriceOrder<S>::better(idx, best_))   // index order is price order
+            best_ = idx;
+    }
+    return levels_[idx];
+}
+
+template <Side S>
+void TickSide<S>::erase_index(size_t idx) {
+    if (!occupied(idx)) return;
+
+    levels_[idx].clear();
+    qty_[rank_of(idx)] = 0;
+    bitmap_[idx >> 6] &= ~(uint64_t{1} << (idx & 63));
+    --count_;
+
+    if (idx != best_) return;
+    best_ = count_ == 0 ? npos : next_from(idx);
+}
+
+// Empty levels are zero in qty_, so the sum runs straight over the ranks
+// from the best level to the last one at or better than price.
+template <Side S>
+uint64_t TickSide<S>::quantity_through(uint64_t price, uint64_t enough) const {
+    if (best_ == npos) return 0;
+
+    size_t last;   // ladder index of the worst level to include
+    if constexpr (S == Side::SELL) {
+        if (price < cfg_.base_price) return 0;
+        uint64_t off = (price - cfg_.base_price) / cfg_.tick_size;
+        last = off >= cfg_.num_levels ? cfg_.num_levels - 1 : static_cast<size_t>(off);
+    } else {
+        uint64_t off = 0;
+        if (price > cfg_.base_price) {
+            uint64_t d = price - cfg_.base_price;
+            off = d / cfg_.tick_size + (d % cfg_.tick_size != 0);   // round up: bids >= price
+        }
+        if (off >= cfg_.num_levels) return 0;
+        last = static_cast<size_t>(off);
+    }
+
+    size_t from = rank_of(best_), to = rank_of(last);
+    if (to < from) return 0;
+    return sum_until(qty_.data() + from, to - from + 1, enough);
+}
+
+// === Bitmap search ===
+
+template <Side S>
+size_t TickSide<S>::next_up(size_t idx) const {
+    size_t word = idx >> 6;
+    uint64_t bits = bitmap_[word] & (~uint64_t{0} << (idx & 63));
+    for (;;) {
+        if (bits)
+            return (word << 6) + static_cast<size_t>(__builtin_ctzll(bits));
+        if (++word == bitmap_.size())
+            return npos;
+        bits = bitmap_[word];
+    }
+}
+
+template <Side S>
+size_t TickSide<S>::next_down(size_t idx) const {
+    size_t word = idx >> 6;
+    uint64_t bits = bitmap_[word] & (~uint64_t{0} >> (63 - (idx & 63)));
+    for (;;) {
+        if (bits)
+            return (word << 6) + 63 - static_cast<size_t>(__builtin_clzll(bits));
+        if (word-- == 0)
+            return npos;
+        bits = bitmap_[word];
+    }
+}
+
+// === Explicit Instantiation ===
+template class TickSide<Side::BUY>;
+template class TickSide<Side::SELL>;
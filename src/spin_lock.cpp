@@ -0,0 +1,40 @@
+#include "spin_lock.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+int* futex_word(std::atomic<uint32_t>& a) {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(int),
+                  "futex needs a plain 32-bit word");
+    return reinterpret_cast<int*>(&a);
+}
+#endif
+
+}  // namespace
+
+void AdaptiveMutex::lock_slow() {
+    // Mark contended; whoever unlocks after this must wake a sleeper.
+    uint32_t c = state_.exchange(2, std::memory_order_acquire);
+    while (c != 0) {
+#ifdef __linux__
+        syscall(SYS_futex, futex_word(state_), FUTEX_WAIT_PRIVATE, 2,
+                nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+        c = state_.exchange(2, std::memory_order_acquire);
+    }
+}
+
+void AdaptiveMutex::wake_one() {
+#ifdef __linux__
+    syscall(SYS_futex, futex_word(state_), FUTEX_WAKE_PRIVATE, 1,
+            nullptr, nullptr, 0);
+#endif
+}
@@ -0,0 +1,187 @@
+#include "thread_placement.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <tuple>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+// First integer in a sysfs file, or fallback if it can't be read.
+int read_sysfs_int(const std::string& path, int fallback) {
+    std::ifstream in(path);
+    int v;
+    return (in >> v) ? v : fallback;
+}
+
+// The kernel exposes a CPU's node as a "nodeN" entry in its sysfs directory.
+int node_of_cpu(int cpu) {
+    std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* d = opendir(dir.c_str());
+    if (!d) return 0;
+    int node = 0;
+    while (dirent* e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0
+            && std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+            node = std::stoi(name.substr(4));
+            break;
+        }
+    }
+    closedir(d);
+    return node;
+}
+#endif
+
+// Per-CPU sort keys derived from the topology.
+struct Ranked {
+    CpuInfo info;
+    int sibling;     // position among the hardware threads of its core
+    int core_rank;   // position of its core within the socket
+};
+
+std::vector<Ranked> rank(const CpuTopology& topo) {
+    std::map<std::pair<int, int>, int> threads_seen;        // (socket, core) → count
+    std::map<std::pair<int, int>, int> core_index;          // (socket, core) → rank
+    std::map<int, int> cores_in_socket;
+
+    std::vector<Ranked> out;
+    for (const CpuInfo& c : topo.cpus()) {
+        auto key = std::make_pair(c.socket, c.core);
+        if (!core_index.count(key))
+            core_index[key] = cores_in_socket[c.socket]++;
+        out.push_back({c, threads_seen[key]++, core_index[key]});
+    }
+    return out;
+}
+
+}  // namespace
+
+// === CpuTopology ===
+
+CpuTopology::CpuTopology(std::vector<CpuInfo> cpus) : cpus_(std::move(cpus)) {
+    std::sort(cpus_.begin(), cpus_.end(),
+              [](const CpuInfo& a, const CpuInfo& b) { return a.cpu < b.cpu; });
+}
+
+CpuTopology CpuTopology::detect() {
+    std::vector<CpuInfo> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &set)) continue;
+            std::string topo = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            cpus.push_back({cpu,
+                            read_sysfs_int(topo + "core_id", cpu),
+                            read_sysfs_int(topo + "physical_package_id", 0),
+                            node_of_cpu(cpu)});
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned hw = std::thread::hardware_concurrency();
+        for (unsigned cpu = 0; cpu < (hw ? hw : 1); ++cpu) {
+            int c = static_cast<int>(cpu);
+            cpus.push_back({c, c, 0, 0});
+        }
+    }
+    return CpuTopology(std::move(cpus));
+}
+
+const CpuInfo* CpuTopology::find(int cpu) const {
+    for (const CpuInfo& c : cpus_)
+        if (c.cpu == cpu) return &c;
+    return nullptr;
+}
+
+size_t CpuTopology::sockets() const {
+    std::vector<int> ids;
+    for (const CpuInfo& c : cpus_) ids.push_back(c.socket);
+    std::sort(ids.begin(), ids.end());
+    return static_cast<size_t>(std::unique(ids.begin(), ids.end()) - ids.begin());
+}
+
+size_t CpuTopology::nodes() const {
+    std::vector<int> ids;
+    for (const CpuInfo& c : cpus_) ids.push_back(c.node);
+    std::sort(ids.begin(), ids.end());
+    return static_cast<size_t>(std::unique(ids.begin(), ids.end()) - ids.begin());
+}
+
+// === Placement ===
+
+const char* placement_name(Placement p) {
+    switch (p) {
+        case Placement::NONE:    return "none";
+        case Placement::COMPACT: return "compact";
+        case Placement::SMT:     return "smt";
+        case Placement::SOCKET:  return "socket";
+        case Placement::CROSS:   return "cross";
+    }
+    return "?";
+}
+
+bool parse_placement(const std::string& name, Placement& out) {
+    for (Placement p : {Placement::NONE, Placement::COMPACT, Placement::SMT,
+                        Placement::SOCKET, Placement::CROSS}) {
+        if (name == placement_name(p)) {
+            out = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<int> plan_threads(const CpuTopology& topo, Placement p, size_t threads) {
+    if (p == Placement::NONE || topo.cpus().empty())
+        return std::vector<int>(threads, -1);
+
+    std::vector<Ranked> order = rank(topo);
+    auto key = [p](const Ranked& r) {
+        const CpuInfo& c = r.info;
+        switch (p) {
+            case Placement::SMT:    return std::make_tuple(c.socket, r.core_rank, r.sibling, c.cpu);
+            case Placement::SOCKET: return std::make_tuple(c.socket, r.sibling, r.core_rank, c.cpu);
+            case Placement::CROSS:  return std::make_tuple(r.sibling, r.core_rank, c.socket, c.cpu);
+            default:                return std::make_tuple(0, 0, 0, c.cpu);
+        }
+    };
+    std::stable_sort(order.begin(), order.end(),
+                     [&](const Ranked& a, const Ranked& b) { return key(a) < key(b); });
+
+    std::vector<int> plan(threads);
+    for (size_t i = 0; i < threads; ++i)
+        plan[i] = order[i % order.size()].info.cpu;
+    return plan;
+}
+
+// === Pinning ===
+
+bool pin_current_thread(int cpu) {
+    if (cpu < 0) return true;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+int current_cpu() {
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
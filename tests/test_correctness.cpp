@@ -1,18 +1,95 @@
 #include "order_book.h"
+#include "matching_engine.h"
+#include "async_book.h"
+#include "book_views.h"
+#include "thread_placement.h"
+#include "work_stealing.h"
+#include "level_scan.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <type_traits>
+#include <map>
+#include <set>
+#include <random>
+#include <unordered_map>
+#include <filesystem>
+#include <cstdlib>
+#include <new>
+#include <chrono>
+#include <csignal>
+#include <ctime>
+#include <fstream>
+#if defined(__unix__)
+#include <sys/resource.h>
+#endif
+
+// Every heap allocation in the process goes through here, so a test can
+// assert that a code path allocated nothing.
+static std::atomic<size_t> g_heap_allocations{0};
+
+// Every form is replaced (array, nothrow and aligned too), so whatever new/delete
+// pair the library picks, both ends are malloc/free.
+static void* counted_alloc(size_t n) noexcept {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(n ? n : 1);
+}
+
+void* operator new(size_t n) {
+    if (void* p = counted_alloc(n))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t n) {
+    if (void* p = counted_alloc(n))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t n, const std::nothrow_t&) noexcept { return counted_alloc(n); }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { return counted_alloc(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+static void* counted_alloc(size_t n, std::align_val_t al) noexcept {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t a = static_cast<size_t>(al);
+    return std::aligned_alloc(a, (n + a - 1) / a * a);
+}
+
+void* operator new(size_t n, std::align_val_t al) {
+    if (void* p = counted_alloc(n, al))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t n, std::align_val_t al) {
+    if (void* p = counted_alloc(n, al))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t n, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_alloc(n, al); }
+void* operator new[](size_t n, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_alloc(n, al); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
 
 // ============================================================
 // 기존 테스트 (템플릿화)
 // ============================================================
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_add_limit_order() {
     std::cout << "[TEST] Add Limit Order\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     assert(book.add_order(Order::Limit(1, 1, Side::BUY, 100, 10)));
     assert(book.best_bid_price() == 100);
@@ -26,10 +103,10 @@ void test_add_limit_order() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_price_time_priority() {
     std::cout << "[TEST] Price-Time Priority\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     book.add_order(Order::Limit(1, 1, Side::SELL, 100, 10));
     book.add_order(Order::Limit(2, 1, Side::SELL, 100, 5));
@@ -44,10 +121,10 @@ void test_price_time_priority() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_cancel_order() {
     std::cout << "[TEST] Cancel Order\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     book.add_order(Order::Limit(1, 1, Side::BUY, 100, 10));
     book.add_order(Order::Limit(2, 1, Side::BUY, 100, 5));
@@ -60,10 +137,10 @@ void test_cancel_order() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_market_order_matching() {
     std::cout << "[TEST] Market Order Matching\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     book.add_order(Order::Limit(1, 1, Side::SELL, 100, 10));
     book.add_order(Order::Limit(2, 1, Side::SELL, 101, 10));
@@ -82,10 +159,10 @@ void test_market_order_matching() {
 // 새 테스트: Edge cases
 // ============================================================
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_partial_fill() {
     std::cout << "[TEST] Partial Fill\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     book.add_order(Order::Limit(1, 1, Side::SELL, 100, 50));
 
@@ -104,10 +181,10 @@ void test_partial_fill() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_multi_level_cross() {
     std::cout << "[TEST] Multi-Level Cross\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     // 3 price levels on sell side
     book.add_order(Order::Limit(1, 1, Side::SELL, 100, 5));
@@ -123,10 +200,10 @@ void test_multi_level_cross() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_cancel_nonexistent() {
     std::cout << "[TEST] Cancel Nonexistent Order\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     assert(book.cancel_order(999) == false);  // nothing to cancel
     assert(book.total_orders() == 0);
@@ -134,10 +211,30 @@ void test_cancel_nonexistent() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
+void test_resting_quantity_limit() {
+    std::cout << "[TEST] Resting Quantity Limit\n";
+    OrderBook<LP, LV> book;
+
+    // Resting quantities are 32-bit: a larger limit order is rejected outright
+    assert(!book.add_order(Order::Limit(1, 1, Side::SELL, 100, kMaxRestingQuantity + 1)));
+    assert(book.add_order(Order::Limit(2, 1, Side::SELL, 100, kMaxRestingQuantity)));
+    assert(book.top_of_book().ask_qty == kMaxRestingQuantity);
+
+    // Market orders never rest, so they may be larger than any resting order
+    ExecutionRing fills(4);
+    assert(book.add_order(Order::Market(3, 1, Side::BUY, kMaxRestingQuantity + 5), &fills));
+    Execution e;
+    assert(fills.pop(e) && e.maker_id == 2 && e.price == 100 && e.quantity == kMaxRestingQuantity);
+    assert(book.total_orders() == 0);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
 void test_empty_book_queries() {
     std::cout << "[TEST] Empty Book Queries\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     assert(book.best_bid_price() == std::nullopt);
     assert(book.best_ask_price() == std::nullopt);
@@ -146,10 +243,10 @@ void test_empty_book_queries() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_cancel_updates_best_price() {
     std::cout << "[TEST] Cancel Updates Best Price\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     book.add_order(Order::Limit(1, 1, Side::BUY, 100, 10));
     book.add_order(Order::Limit(2, 1, Side::BUY, 105, 10));
@@ -163,10 +260,10 @@ void test_cancel_updates_best_price() {
     std::cout << "  PASSED\n";
 }
 
-template <typename LP>
+template <typename LP, typename LV>
 void test_concurrent_add_cancel() {
     std::cout << "[TEST] Concurrent Add + Cancel\n";
-    OrderBook<LP> book;
+    OrderBook<LP, LV> book;
 
     const int NUM_THREADS = 4;
     const int OPS_PER_THREAD = 10000;
@@ -203,36 +300,1859 @@ void test_concurrent_add_cancel() {
     std::cout << "  PASSED (no crash, consistent state)\n";
 }
 
+template <typename LP, typename LV>
+void test_cancel_middle_of_level() {
+    std::cout << "[TEST] Cancel Middle of Level Keeps FIFO\n";
+    OrderBook<LP, LV> book;
+
+    book.add_order(Order::Limit(1, 1, Side::SELL, 100, 10));
+    book.add_order(Order::Limit(2, 1, Side::SELL, 100, 5));
+    book.add_order(Order::Limit(3, 1, Side::SELL, 100, 5));
+
+    assert(book.cancel_order(2) == true);
+
+    // Market buy 12: order 1 (10) then order 3 (2 partial)
+    book.add_order(Order::Market(10, 1, Side::BUY, 12));
+    assert(book.total_orders() == 1);
+    assert(book.cancel_order(1) == false);  // already filled
+
+    assert(book.cancel_order(3) == true);
+    assert(book.best_ask_price() == std::nullopt);
+    assert(book.total_ask_levels() == 0);
+
+    // Recycled nodes behave like fresh ones
+    for (uint64_t id = 100; id < 10100; ++id) {
+        assert(book.add_order(Order::Limit(id, 1, Side::BUY, 90 + id % 5, 1)));
+        if (id % 2 == 0) assert(book.cancel_order(id));
+    }
+    assert(book.total_orders() == 5000);
+    assert(book.best_bid_price() == 94);
+
+    std::cout << "  PASSED\n";
+}
+
 // ============================================================
-// Run all tests for a given policy
+// 새 테스트: Matching engine
 // ============================================================
 
-template <typename LP>
-void run_all_tests(const std::string& label) {
-    std::cout << "========================================\n";
-    std::cout << "Testing: " << label << "\n";
-    std::cout << "========================================\n\n";
+template <typename LP, typename LV>
+void test_marketable_limit_crosses() {
+    std::cout << "[TEST] Marketable Limit Order Crosses and Rests Remainder\n";
+    OrderBook<LP, LV> book;
+    ExecutionRing fills(16);
 
-    test_add_limit_order<LP>();
-    test_price_time_priority<LP>();
-    test_cancel_order<LP>();
-    test_market_order_matching<LP>();
-    test_partial_fill<LP>();
-    test_multi_level_cross<LP>();
-    test_cancel_nonexistent<LP>();
-    test_empty_book_queries<LP>();
-    test_cancel_updates_best_price<LP>();
-    test_concurrent_add_cancel<LP>();
+    book.add_order(Order::Limit(1, 1, Side::SELL, 100, 5));
+    book.add_order(Order::Limit(2, 1, Side::SELL, 101, 5));
+    book.add_order(Order::Limit(3, 1, Side::SELL, 103, 5));
 
-    std::cout << "\nAll " << label << " tests PASSED.\n\n";
+    // Buy 12 @ 101: takes 100 and 101, stops before 103, rests 2 @ 101
+    assert(book.add_order(Order::Limit(10, 1, Side::BUY, 101, 12), &fills));
+
+    assert(fills.size() == 2);
+    assert(fills[0].maker_id == 1 && fills[0].taker_id == 10);
+    assert(fills[0].price == 100 && fills[0].quantity == 5);
+    assert(fills[1].maker_id == 2 && fills[1].price == 101 && fills[1].quantity == 5);
+    assert(fills[1].seq == fills[0].seq + 1);
+
+    assert(book.best_bid_price() == 101);
+    assert(book.best_ask_price() == 103);
+    assert(book.total_orders() == 2);  // resting remainder + order 3
+
+    // Non-marketable limit just rests
+    fills.clear();
+    assert(book.add_order(Order::Limit(11, 1, Side::SELL, 102, 5), &fills));
+    assert(fills.empty());
+    assert(book.best_ask_price() == 102);
+
+    std::cout << "  PASSED\n";
 }
 
-int main() {
-    run_all_tests<MutexPolicy>("MutexPolicy");
-    run_all_tests<SharedMutexPolicy>("SharedMutexPolicy");
+template <typename LP, typename LV>
+void test_sell_sweeps_from_best_bid() {
+    std::cout << "[TEST] Sell Sweeps Bids From Best Price\n";
+    OrderBook<LP, LV> book;
+    ExecutionRing fills(16);
+
+    book.add_order(Order::Limit(1, 1, Side::BUY, 98, 5));
+    book.add_order(Order::Limit(2, 1, Side::BUY, 100, 5));
+    book.add_order(Order::Limit(3, 1, Side::BUY, 99, 5));
+
+    // Market sell 7: 5 @ 100 then 2 @ 99; 98 untouched
+    book.add_order(Order::Market(10, 1, Side::SELL, 7), &fills);
+    assert(fills.size() == 2);
+    assert(fills[0].maker_id == 2 && fills[0].price == 100);
+    assert(fills[1].maker_id == 3 && fills[1].price == 99 && fills[1].quantity == 2);
+    assert(book.best_bid_price() == 99);
+
+    // Limit sell 10 @ 99 takes the 3 left at 99 and rests 7 @ 99
+    fills.clear();
+    book.add_order(Order::Limit(11, 1, Side::SELL, 99, 10), &fills);
+    assert(fills.size() == 1 && fills[0].quantity == 3);
+    assert(book.best_bid_price() == 98);
+    assert(book.best_ask_price() == 99);
+
+    std::cout << "  PASSED\n";
+}
+
+// Whole levels taken at once must leave the same book as order-by-order
+// matching: fills in price-time order, ids gone, icebergs requeued.
+template <typename LP, typename LV>
+void test_deep_sweep_takes_whole_levels() {
+    std::cout << "[TEST] Deep Sweep Takes Whole Levels\n";
+    OrderBook<LP, LV> book;
+    ExecutionRing fills(1024);
+
+    // 100 bid levels of 3 orders; the middle one of level 50 is an iceberg
+    uint64_t id = 1;
+    for (uint64_t l = 0; l < 100; ++l)
+        for (int k = 0; k < 3; ++k, ++id) {
+            if (l == 50 && k == 1)
+                book.add_order(Order::Iceberg(id, 1, Side::BUY, 1000 - l, 30, 10));
+            else
+                book.add_order(Order::Limit(id, 1, Side::BUY, 1000 - l, 10));
+        }
+
+    // 50 whole levels, then level 50 whole (its iceberg refills and goes to
+    // the back), then 15 more from it
+    assert(book.add_order(Order::Market(1000, 1, Side::SELL, 50 * 30 + 30 + 15), &fills));
+    assert(fills.size() == 150 + 3 + 2);
+    for (size_t i = 0; i < 150; ++i) {
+        assert(fills[i].maker_id == i + 1 && fills[i].quantity == 10);
+        assert(fills[i].price == 1000 - i / 3 && fills[i].seq == fills[0].seq + i);
+    }
+    assert(fills[150].maker_id == 151 && fills[151].maker_id == 152 && fills[152].maker_id == 153);
+    assert(fills[153].maker_id == 152 && fills[153].quantity == 10);   // refilled slice
+    assert(fills[154].maker_id == 152 && fills[154].quantity == 5);
+
+    assert(book.best_bid_price() == 950 && book.total_bid_levels() == 50);
+    TopOfBook top = book.top_of_book();
+    assert(top.bid_qty == 5);                        // last slice; the reserve is spent
+    assert(book.total_orders() == 1 + 49 * 3);
+    for (uint64_t i = 1; i <= 150; ++i)
+        assert(!book.cancel_order(i));               // swept ids are gone...
+    assert(book.add_order(Order::Limit(1, 1, Side::BUY, 940, 10)));   // ...and reusable
+
+    // A limit that covers levels exactly stops at its price and rests nothing
+    fills.clear();
+    assert(book.add_order(Order::Limit(2000, 1, Side::SELL, 949, 5 + 30), &fills));
+    assert(fills.size() == 4 && fills[0].price == 950 && fills[3].price == 949);
+    assert(book.best_bid_price() == 948 && !book.best_ask_price());
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_execution_ring_overflow() {
+    std::cout << "[TEST] Execution Ring Overflow Drops Instead of Allocating\n";
+    OrderBook<LP, LV> book;
+    ExecutionRing fills(4);
+
+    for (uint64_t id = 1; id <= 6; ++id)
+        book.add_order(Order::Limit(id, 1, Side::SELL, 100, 1));
+
+    book.add_order(Order::Market(10, 1, Side::BUY, 6), &fills);
+    assert(book.total_orders() == 0);   // matching is not limited by the sink
+    assert(fills.size() == 4);
+    assert(fills.dropped() == 2);
+
+    Execution e;
+    assert(fills.pop(e) && e.maker_id == 1);
+    assert(fills.size() == 3);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Batch API
+// ============================================================
+
+template <typename LP, typename LV>
+void test_batch_add_cancel() {
+    std::cout << "[TEST] Batch Add/Cancel Matches Single-Order Semantics\n";
+    OrderBook<LP, LV> book;
+    ExecutionRing fills(16);
+
+    const Order batch[] = {
+        Order::Limit(1, 1, Side::BUY,  100, 10),
+        Order::Limit(2, 1, Side::BUY,  100, 5),    // same level as 1
+        Order::Limit(1, 1, Side::BUY,  101, 5),    // duplicate id
+        Order::Limit(3, 1, Side::SELL, 105, 5),
+        Order::Limit(4, 1, Side::SELL, 100, 12),   // crosses 1 and 2 in arrival order
+        Order::Limit(5, 1, Side::BUY,  100, 7),    // joins what is left of 2
+    };
+    bool status[6];
+
+    assert(book.add_orders(batch, 6, status, &fills) == 5);
+    assert(status[0] && status[1] && !status[2] && status[3] && status[4] && status[5]);
+
+    assert(fills.size() == 2);
+    assert(fills[0].maker_id == 1 && fills[0].quantity == 10);
+    assert(fills[1].maker_id == 2 && fills[1].quantity == 2);
+
+    // Order 2 (3 left) and order 5 rest at 100; order 3 at 105
+    assert(book.total_orders() == 3);
+    assert(book.top_of_book().bid_qty == 10);
+    assert(book.best_ask_price() == 105);
+
+    const uint64_t ids[] = {2, 999, 2, 3};
+    bool cancelled[4];
+    assert(book.cancel_orders(ids, 4, cancelled) == 2);
+    assert(cancelled[0] && !cancelled[1] && !cancelled[2] && cancelled[3]);
+
+    assert(book.total_orders() == 1);
+    assert(book.best_ask_price() == std::nullopt);
+    assert(book.top_of_book().bid_qty == 7);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_apply_batch_mixed() {
+    std::cout << "[TEST] Mixed Batch Reports Per-Command Fills\n";
+    OrderBook<LP, LV> book;
+    ExecutionRing fills(16);
+
+    const BookCommand batch[] = {
+        BookCommand::Add(Order::Limit(1, 1, Side::SELL, 101, 5)),
+        BookCommand::Add(Order::Limit(2, 1, Side::SELL, 102, 5)),
+        BookCommand::Add(Order::Limit(3, 1, Side::BUY,  102, 7)),   // takes 1, then 2 from 2
+        BookCommand::Cancel(1),                                     // already filled
+        BookCommand::Modify(2, 102, 1),                             // 3 left → 1, keeps place
+        BookCommand::Add(Order::Limit(2, 1, Side::BUY,  90, 1)),    // duplicate id
+        BookCommand::Add(Order::Limit(4, 1, Side::BUY,  95, 3)),
+        BookCommand::Modify(4, 102, 3),                             // reprice: crosses 2
+        BookCommand::Cancel(4),                                     // 2 left of 4
+    };
+    BookResult r[9];
+
+    assert(book.apply_batch(batch, 9, r, &fills) == 7);
+    assert(r[0].accepted && r[0].fills == 0 && r[1].accepted);
+    assert(r[2].accepted && r[2].fills == 2 && r[2].filled_qty == 7);
+    assert(!r[3].accepted && r[4].accepted && r[4].fills == 0);
+    assert(!r[5].accepted && r[6].accepted);
+    assert(r[7].accepted && r[7].fills == 1 && r[7].filled_qty == 1);
+    assert(r[8].accepted);
+    assert(fills.size() == 3 && fills[2].maker_id == 2 && fills[2].taker_id == 4);
+    assert(book.total_orders() == 0);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Top of book
+// ============================================================
+
+template <typename LP, typename LV>
+void test_top_of_book() {
+    std::cout << "[TEST] Top of Book Snapshot\n";
+    OrderBook<LP, LV> book;
+
+    TopOfBook t = book.top_of_book();
+    assert(!t.has_bid() && !t.has_ask());
+
+    book.add_order(Order::Limit(1, 1, Side::BUY, 99, 10));
+    book.add_order(Order::Limit(2, 1, Side::BUY, 99, 5));
+    book.add_order(Order::Limit(3, 1, Side::SELL, 101, 7));
+    book.add_order(Order::Limit(4, 1, Side::SELL, 102, 7));
+
+    t = book.top_of_book();
+    assert(t.bid_price == 99 && t.bid_qty == 15);
+    assert(t.ask_price == 101 && t.ask_qty == 7);
+
+    // Partial fill shrinks the best ask size
+    uint64_t seq_before = t.seq;
+    book.add_order(Order::Market(5, 1, Side::BUY, 3));
+    t = book.top_of_book();
+    assert(t.ask_price == 101 && t.ask_qty == 4);
+    assert(t.seq > seq_before);
+
+    // No visible change, no new publication
+    seq_before = t.seq;
+    book.add_order(Order::Limit(6, 1, Side::BUY, 90, 1));
+    assert(book.top_of_book().seq == seq_before);
+
+    book.cancel_order(3);
+    t = book.top_of_book();
+    assert(t.ask_price == 102 && t.ask_qty == 7);
+    assert(book.best_ask_price() == 102);
+    assert(book.best_bid_price() == 99);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_concurrent_top_of_book_never_torn() {
+    std::cout << "[TEST] Concurrent Top of Book Never Crossed or Torn\n";
+    OrderBook<LP, LV> book;
+    std::atomic<bool> done{false};
+
+    // Matching keeps bid < ask at every write-lock release, so a reader that
+    // ever sees bid >= ask has observed a torn snapshot.
+    std::thread writer([&]() {
+        uint64_t id = 1;
+        for (int i = 0; i < 20000; ++i) {
+            uint64_t price = 95 + (i * 7) % 11;
+            Side side = (i % 3 == 0) ? Side::SELL : Side::BUY;
+            book.add_order(Order::Limit(id++, 1, side, price, 1 + i % 4));
+            if (i % 5 == 0) book.cancel_order(id - 3);
+        }
+        done.store(true);
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&]() {
+            uint64_t last_seq = 0;
+            while (!done.load()) {
+                TopOfBook t = book.top_of_book();
+                assert(t.seq >= last_seq);
+                last_seq = t.seq;
+                if (t.has_bid() && t.has_ask())
+                    assert(t.bid_price < t.ask_price);
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& t : readers) t.join();
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Market depth and level-delta feed
+// ============================================================
+
+template <typename LP, typename LV>
+void test_depth_snapshot() {
+    std::cout << "[TEST] Depth Snapshot Aggregates Levels\n";
+    OrderBook<LP, LV> book;
+
+    book.add_order(Order::Limit(1, 1, Side::BUY, 99, 10));
+    book.add_order(Order::Limit(2, 1, Side::BUY, 99, 5));
+    book.add_order(Order::Limit(3, 1, Side::BUY, 97, 1));
+    book.add_order(Order::Limit(4, 1, Side::BUY, 98, 2));
+    book.add_order(Order::Limit(5, 1, Side::SELL, 101, 3));
+    book.add_order(Order::Limit(6, 1, Side::SELL, 103, 4));
+
+    BookDepth d = book.depth(2);
+    assert(d.bids.size() == 2 && d.asks.size() == 2);
+    assert(d.bids[0].price == 99 && d.bids[0].quantity == 15 && d.bids[0].order_count == 2);
+    assert(d.bids[1].price == 98 && d.bids[1].quantity == 2);
+    assert(d.asks[0].price == 101 && d.asks[1].price == 103);
+
+    book.add_order(Order::Market(7, 1, Side::SELL, 12));   // 12 off the 99 level
+    d = book.depth(10);
+    assert(d.bids.size() == 3);
+    assert(d.bids[0].price == 99 && d.bids[0].quantity == 3 && d.bids[0].order_count == 1);
+
+    d = book.depth(SIZE_MAX);   // "everything": reserves what the book has, not n
+    assert(d.bids.size() == 3 && d.asks.size() == 2);
+
+    std::cout << "  PASSED\n";
+}
+
+// quantity_through() against sums over depth(), through random churn and
+// after a snapshot load. Tick 5, so some query prices fall between ticks.
+template <typename LP, typename LV>
+void test_quantity_through() {
+    std::cout << "[TEST] Quantity Through Price Matches Depth\n";
+    OrderBook<LP, LV> book(LadderConfig{1000, 5, 400});   // 1000 .. 2995
+    std::mt19937_64 rng(23);
+    std::vector<uint64_t> ids;
+
+    auto check = [](const OrderBook<LP, LV>& b) {
+        BookDepth d = b.depth(400);   // every level in the band
+        for (uint64_t p : {uint64_t{0}, uint64_t{999}, uint64_t{1000}, uint64_t{1002},
+                           uint64_t{1500}, uint64_t{1998}, uint64_t{2000}, uint64_t{2003},
+                           uint64_t{2500}, uint64_t{2995}, uint64_t{3000}, UINT64_MAX}) {
+            uint64_t bids = 0, asks = 0;
+            for (const LevelInfo& l : d.bids) if (l.price >= p) bids += l.quantity;
+            for (const LevelInfo& l : d.asks) if (l.price <= p) asks += l.quantity;
+            assert(b.quantity_through(Side::BUY, p) == bids);
+            assert(b.quantity_through(Side::SELL, p) == asks);
+        }
+    };
+
+    check(book);   // empty
+    for (uint64_t id = 1; id <= 6000; ++id) {
+        uint64_t r = rng() % 100;
+        if (r < 55 || ids.empty()) {
+            bool buy = rng() & 1;
+            uint64_t tick = buy ? 20 + rng() % 190 : 190 + rng() % 190;   // overlap crosses
+            Side side = buy ? Side::BUY : Side::SELL;
+            if (r % 7 == 0)
+                book.add_order(Order::Iceberg(id, 1, side, 1000 + 5 * tick, 40, 10));
+            else
+                book.add_order(Order::Limit(id, 1, side, 1000 + 5 * tick, 1 + rng() % 50));
+            ids.push_back(id);
+        } else if (r < 85) {
+            size_t k = rng() % ids.size();
+            book.cancel_order(ids[k]);
+            ids[k] = ids.back();
+            ids.pop_back();
+        } else if (r < 95) {
+            book.modify_order(ids[rng() % ids.size()], 1000 + 5 * (100 + rng() % 200), 1 + rng() % 50);
+        } else {
+            book.add_order(Order::Market(id, 1, (rng() & 1) ? Side::BUY : Side::SELL, rng() % 300));
+        }
+        if (id % 100 == 0)
+            check(book);
+    }
+
+    // A loaded book fills the quantity array too
+    BookSnapshot snap;
+    book.snapshot(snap);
+    OrderBook<LP, LV> copy(LadderConfig{1000, 5, 400});
+    assert(copy.load(snap));
+    check(copy);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_level_delta_feed() {
+    std::cout << "[TEST] Level-Delta Feed Rebuilds the Same L2 Book\n";
+    OrderBook<LP, LV> book;
+    SpscQueue<LevelDelta> feed(4096);
+    book.set_delta_feed(&feed);
+
+    uint64_t id = 1;
+    for (int i = 0; i < 400; ++i) {
+        Side side = (i % 2) ? Side::SELL : Side::BUY;
+        uint64_t price = side == Side::BUY ? 90 + i % 9 : 96 + i % 9;   // overlapping → crosses
+        book.add_order(Order::Limit(id++, 1, side, price, 1 + i % 7));
+        if (i % 4 == 3) book.cancel_order(id - 3);
+        if (i % 50 == 49) book.add_order(Order::Market(id++, 1, Side::BUY, 20));
+    }
+
+    // Consumer's own L2 view, built only from deltas
+    std::map<uint64_t, LevelInfo> bids, asks;
+    LevelDelta d;
+    uint64_t last_seq = 0;
+    while (feed.try_pop(d)) {
+        assert(d.seq == last_seq + 1);
+        last_seq = d.seq;
+        auto& side = d.side == Side::BUY ? bids : asks;
+        if (d.quantity == 0) side.erase(d.price);
+        else side[d.price] = LevelInfo{d.price, d.quantity, d.order_count};
+    }
+
+    BookDepth snap = book.depth(1000);
+    assert(snap.seq == last_seq);
+    assert(snap.bids.size() == bids.size() && snap.asks.size() == asks.size());
+    auto bit = bids.rbegin();
+    for (const auto& l : snap.bids) {
+        assert(bit->second.price == l.price && bit->second.quantity == l.quantity
+               && bit->second.order_count == l.order_count);
+        ++bit;
+    }
+    auto ait = asks.begin();
+    for (const auto& l : snap.asks) {
+        assert(ait->second.price == l.price && ait->second.quantity == l.quantity);
+        ++ait;
+    }
+
+    // Overflow: deltas are dropped and counted, seq keeps advancing
+    SpscQueue<LevelDelta> tiny(2);
+    book.set_delta_feed(&tiny);
+    for (int i = 0; i < 5; ++i)
+        book.add_order(Order::Limit(id++, 1, Side::BUY, 50 + i, 1));
+    assert(book.dropped_deltas() == 3);
+    assert(book.depth(1).seq == last_seq + 5);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Time in force, post-only, iceberg
+// ============================================================
+
+template <typename LP, typename LV>
+void test_ioc_and_fok() {
+    std::cout << "[TEST] IOC and FOK\n";
+    OrderBook<LP, LV> book;
+    book.add_order(Order::Limit(1, 1, Side::SELL, 100, 5));
+    book.add_order(Order::Limit(2, 1, Side::SELL, 101, 5));
+    book.add_order(Order::Limit(3, 1, Side::SELL, 103, 5));
+
+    // IOC: takes what crosses (100, 101), drops the rest instead of resting
+    assert(book.add_order(Order::Limit(10, 1, Side::BUY, 101, 12).with_tif(TimeInForce::IOC)));
+    assert(book.total_orders() == 1);
+    assert(book.best_bid_price() == std::nullopt);
+    assert(book.best_ask_price() == 103);
+
+    // FOK: 5 available within the limit, 6 asked → rejected, book untouched
+    ExecutionRing fills(8);
+    assert(!book.add_order(Order::Limit(11, 1, Side::BUY, 103, 6).with_tif(TimeInForce::FOK), &fills));
+    assert(fills.size() == 0 && book.total_orders() == 1);
+    assert(!book.add_order(Order::Limit(12, 1, Side::BUY, 102, 1).with_tif(TimeInForce::FOK)));
+
+    // FOK that fits fills completely across levels
+    book.add_order(Order::Limit(4, 1, Side::SELL, 104, 5));
+    assert(book.add_order(Order::Limit(13, 1, Side::BUY, 104, 8).with_tif(TimeInForce::FOK), &fills));
+    assert(fills.size() == 2);
+    assert(book.total_orders() == 1 && book.top_of_book().ask_qty == 2);
+
+    // Market FOK ignores price but still needs the full size
+    assert(!book.add_order(Order::Market(14, 1, Side::BUY, 3).with_tif(TimeInForce::FOK)));
+    assert(book.add_order(Order::Market(15, 1, Side::BUY, 2).with_tif(TimeInForce::FOK)));
+    assert(book.total_orders() == 0);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_post_only() {
+    std::cout << "[TEST] Post-Only\n";
+    OrderBook<LP, LV> book;
+    book.add_order(Order::Limit(1, 1, Side::SELL, 100, 5));
+
+    assert(!book.add_order(Order::Limit(2, 1, Side::BUY, 100, 5).with_post_only()));   // would cross
+    assert(book.add_order(Order::Limit(3, 1, Side::BUY, 99, 5).with_post_only()));     // rests
+    assert(!book.add_order(Order::Market(4, 1, Side::BUY, 5).with_post_only()));       // always crosses
+    assert(book.total_orders() == 2);
+    assert(book.top_of_book().ask_qty == 5 && book.top_of_book().bid_qty == 5);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_iceberg_replenish() {
+    std::cout << "[TEST] Iceberg Shows a Slice and Requeues\n";
+    OrderBook<LP, LV> book;
+
+    book.add_order(Order::Iceberg(1, 1, Side::SELL, 100, 25, 10));
+    book.add_order(Order::Limit(2, 1, Side::SELL, 100, 4));
+    assert(book.top_of_book().ask_qty == 14);          // only the slice is visible
+
+    // Slice of 10 fills; the refill goes behind order 2
+    ExecutionRing fills(16);
+    book.add_order(Order::Market(3, 1, Side::BUY, 12), &fills);
+    Execution e;
+    assert(fills.pop(e) && e.maker_id == 1 && e.quantity == 10);
+    assert(fills.pop(e) && e.maker_id == 2 && e.quantity == 2);
+    assert(book.top_of_book().ask_qty == 12);          // 2 left of order 2 + new slice 10
+
+    // Sweep the rest: 2 from order 2, then slices of 10 and 5
+    book.add_order(Order::Market(4, 1, Side::BUY, 100), &fills);
+    assert(fills.pop(e) && e.maker_id == 2 && e.quantity == 2);
+    assert(fills.pop(e) && e.maker_id == 1 && e.quantity == 10);
+    assert(fills.pop(e) && e.maker_id == 1 && e.quantity == 5);
+    assert(!fills.pop(e));
+    assert(book.total_orders() == 0 && !book.best_ask_price());
+
+    // Cancel drops the hidden reserve too
+    book.add_order(Order::Iceberg(5, 1, Side::BUY, 99, 50, 5));
+    assert(book.cancel_order(5));
+    assert(book.total_orders() == 0 && book.depth(1).bids.empty());
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Modify / replace
+// ============================================================
+
+template <typename LP, typename LV>
+void test_modify_keeps_or_resets_priority() {
+    std::cout << "[TEST] Modify Keeps or Resets Priority\n";
+    OrderBook<LP, LV> book;
+    book.add_order(Order::Limit(1, 1, Side::SELL, 100, 5));
+    book.add_order(Order::Limit(2, 1, Side::SELL, 100, 5));
+
+    // Size down in place: order 1 stays at the front
+    assert(book.modify_order(1, 100, 3));
+    assert(book.top_of_book().ask_qty == 8);
+    ExecutionRing fills(8);
+    book.add_order(Order::Market(10, 1, Side::BUY, 1), &fills);
+    Execution e;
+    assert(fills.pop(e) && e.maker_id == 1);
+
+    // Size up: order 1 goes behind order 2
+    assert(book.modify_order(1, 100, 6));
+    assert(book.top_of_book().ask_qty == 11);
+    book.add_order(Order::Market(11, 1, Side::BUY, 1), &fills);
+    assert(fills.pop(e) && e.maker_id == 2);
+
+    // Rejected amends change nothing
+    assert(!book.modify_order(99, 100, 1));
+    assert(!book.modify_order(1, 100, 0));
+    assert(!book.modify_order(1, 100, kMaxRestingQuantity + 1));
+    assert(book.total_orders() == 2 && book.top_of_book().ask_qty == 10);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_modify_reprice() {
+    std::cout << "[TEST] Modify Reprices and Crosses\n";
+    OrderBook<LP, LV> book;
+    book.add_order(Order::Limit(1, 1, Side::SELL, 102, 5));
+    book.add_order(Order::Limit(2, 1, Side::BUY, 98, 4));
+    book.add_order(Order::Limit(3, 1, Side::BUY, 97, 4));
+
+    // Move to a new non-crossing price: old level disappears
+    assert(book.modify_order(1, 101, 5));
+    assert(book.best_ask_price() == 101 && book.total_ask_levels() == 1);
+
+    // Move through the bids: trades like an incoming sell, rests the rest
+    ExecutionRing fills(8);
+    assert(book.modify_order(1, 98, 6, &fills));
+    Execution e;
+    assert(fills.pop(e) && e.maker_id == 2 && e.taker_id == 1 && e.price == 98 && e.quantity == 4);
+    assert(book.best_ask_price() == 98 && book.top_of_book().ask_qty == 2);
+    assert(book.best_bid_price() == 97);
+
+    // Fully filled by the move: gone from the book
+    assert(book.modify_order(1, 97, 2, &fills));
+    assert(book.total_orders() == 1 && !book.best_ask_price());
+    assert(book.top_of_book().bid_qty == 2);
+
+    // Icebergs shed hidden reserve first on a size-down
+    book.add_order(Order::Iceberg(4, 1, Side::SELL, 105, 30, 10));
+    assert(book.modify_order(4, 105, 12));
+    assert(book.top_of_book().ask_qty == 10);
+    assert(book.modify_order(4, 105, 7));
+    assert(book.top_of_book().ask_qty == 7);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Side-specialized level storage
+// ============================================================
+
+static_assert(PriceOrder<Side::BUY>::better(101, 100) && !PriceOrder<Side::SELL>::better(101, 100));
+static_assert(PriceOrder<Side::BUY>::within(100, 100) && PriceOrder<Side::BUY>::within(101, 100));
+static_assert(PriceOrder<Side::SELL>::within(99, 100) && !PriceOrder<Side::SELL>::within(101, 100));
+static_assert(PriceOrder<Side::BUY>::within(1, PriceOrder<Side::BUY>::worst));
+static_assert(PriceOrder<Side::SELL>::within(UINT64_MAX, PriceOrder<Side::SELL>::worst));
+static_assert(!std::is_same_v<MapLevels::side<Side::BUY>, MapLevels::side<Side::SELL>>);
+
+// One side of a backend on its own: best end, walk order and sums follow
+// the side the type was instantiated for.
+template <typename LV, Side S>
+void check_side_levels() {
+    typename LV::template side<S> side(LadderConfig{1000, 5, 64});
+    for (uint64_t p : {1100, 1005, 1300, 1050, 1200}) {
+        side.level(p).quantity = p - 1000;
+        side.set_quantity(p, p - 1000);
+    }
+    std::vector<uint64_t> want = {1005, 1050, 1100, 1200, 1300};
+    if (S == Side::BUY) std::reverse(want.begin(), want.end());
+
+    std::vector<uint64_t> seen;
+    side.for_each_from_best(SIZE_MAX, [&](uint64_t p, const PriceLevel&) { seen.push_back(p); });
+    assert(seen == want && side.size() == 5);
+    assert(side.best_price() == want[0] && side.best()->quantity == want[0] - 1000);
+
+    uint64_t through = 0;   // want[0..2]
+    for (size_t i = 0; i < 3; ++i) through += want[i] - 1000;
+    assert(side.quantity_through(want[2], UINT64_MAX) == through);
+    assert(side.quantity_through(PriceOrder<S>::worst, UINT64_MAX) == 5 + 50 + 100 + 200 + 300);
+
+    side.pop_best();
+    assert(side.best_price() == want[1]);
+    side.erase(want[2]);
+    side.erase(want[1]);
+    assert(side.best_price() == want[3] && side.size() == 2);
+}
+
+template <typename LV>
+void test_side_levels() {
+    std::cout << "[TEST] Side-Specialized Levels Order Best First\n";
+    check_side_levels<LV, Side::BUY>();
+    check_side_levels<LV, Side::SELL>();
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Level scan kernels
+// ============================================================
+
+void test_level_scan_kernels() {
+    std::cout << "[TEST] Level Scan Kernels Agree With Plain Loops\n";
+    std::mt19937_64 rng(31);
+    std::vector<uint64_t> q(600);
+
+    for (const LevelScanKernels& k : available_level_scan_kernels()) {
+        for (int round = 0; round < 2000; ++round) {
+            // Unaligned starts, lengths around the vector and chunk sizes
+            size_t off = rng() % 8, n = rng() % (q.size() - off);
+            uint64_t* a = q.data() + off;
+            for (size_t i = 0; i < n; ++i)
+                a[i] = (rng() % 3 == 0) ? 0 : rng() % 1000;
+
+            uint64_t full = 0;
+            for (size_t i = 0; i < n; ++i) full += a[i];
+            uint64_t enough = (round % 4 == 0) ? UINT64_MAX : rng() % (full + 2);
+            uint64_t got = k.sum_until(a, n, enough);
+            if (full < enough)
+                assert(got == full);
+            else
+                assert(got >= enough && got <= full);
+        }
+    }
+    assert(level_scan_kernels().isa == available_level_scan_kernels().front().isa);
+
+    std::cout << "  PASSED (" << level_scan_kernels().isa << ")\n";
+}
+
+// ============================================================
+// 새 테스트: Instrumentation
+// ============================================================
+
+void test_log_histogram() {
+    std::cout << "[TEST] Log Histogram Percentiles\n";
+    LogHistogram h;
+    for (uint64_t v = 1; v <= 10000; ++v)
+        h.record(v);
+
+    assert(h.count() == 10000 && h.max() == 10000);
+    for (double p : {50.0, 90.0, 99.0}) {
+        double exact = p / 100.0 * 10000;
+        double got = static_cast<double>(h.percentile(p));
+        assert(got <= exact && got >= exact * 0.875);   // bucket lower bound, 12.5% wide
+    }
+    assert(h.percentile(0) == 1);
+
+    LogHistogram other;
+    other.record(uint64_t{1} << 40);
+    h.merge(other);
+    assert(h.count() == 10001 && h.max() == uint64_t{1} << 40);
+    assert(h.percentile(100) == uint64_t{1} << 40);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_book_stats() {
+    std::cout << "[TEST] Book Stats Policy Counts Operations\n";
+    OrderBook<LP, LV, HistogramStatsPolicy> book;
+
+    book.add_order(Order::Limit(1, 1, Side::SELL, 100, 5));
+    book.add_order(Order::Limit(2, 1, Side::SELL, 100, 5));
+    book.add_order(Order::Limit(3, 1, Side::SELL, 101, 5));
+    book.cancel_order(1);                                   // level 100 held 2 orders
+    book.add_order(Order::Market(4, 1, Side::BUY, 10));     // 2 fills, both levels gone
+    book.add_order(Order::Limit(5, 1, Side::BUY, 99, 5));   // no trade: no match sample
+    Order batch[] = {Order::Limit(6, 1, Side::BUY, 98, 1), Order::Limit(7, 1, Side::BUY, 98, 1)};
+    bool ok[2];
+    book.add_orders(batch, 2, ok);
+
+    BookStatsSnapshot st = book.stats().snapshot();
+    assert(st.wait[int(BookOp::ADD)].count() == 5 && st.hold[int(BookOp::ADD)].count() == 5);
+    assert(st.hold[int(BookOp::CANCEL)].count() == 1);
+    assert(st.hold[int(BookOp::BATCH)].count() == 1);
+    assert(st.hold[int(BookOp::MODIFY)].count() == 0);
+    assert(st.match.count() == 1);
+    assert(st.fills == 2);
+    assert(st.levels_created == 4 && st.levels_erased == 2);
+    assert(st.cancel_depth.count() == 1 && st.cancel_depth.max() == 2);
+    assert(ticks_per_ns() > 0);
+
+    std::cout << "  PASSED\n";
+}
+
+// More recording threads than slots: the overflow shares a slot and must
+// still count every event.
+void test_book_stats_many_threads() {
+    std::cout << "[TEST] Book Stats Count Every Event Past the Slot Limit\n";
+    HistogramStatsPolicy stats;
+    const size_t THREADS = 3 * HistogramStatsPolicy::kSlots;
+    const uint64_t EVENTS = 20000;
+
+    std::atomic<size_t> ready{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&]() {
+            ready.fetch_add(1);
+            while (ready.load() < THREADS) std::this_thread::yield();   // all alive at once
+            for (uint64_t i = 0; i < EVENTS; ++i) {
+                stats.on_fill();
+                stats.on_cancel(static_cast<uint32_t>(i % 4));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    BookStatsSnapshot st = stats.snapshot();
+    assert(st.fills == THREADS * EVENTS);
+    assert(st.cancel_depth.count() == THREADS * EVENTS);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Preallocation
+// ============================================================
+
+template <typename LP, typename LV>
+void test_reserved_book_does_not_allocate() {
+    std::cout << "[TEST] Reserved Book Makes No Heap Allocations\n";
+    BookConfig cfg;
+    cfg.max_orders = 2048;
+    cfg.max_levels = 128;
+    OrderBook<LP, LV> book(cfg);
+    ExecutionRing fills(256);
+
+    size_t before = g_heap_allocations.load();
+
+    // Deep orders that outlive the id window and move to the index table
+    uint64_t id = 1;
+    for (int i = 0; i < 100; ++i) {
+        book.add_order(Order::Limit(id++, 1, Side::BUY, 800, 10));
+        book.add_order(Order::Limit(id++, 1, Side::SELL, 1200, 10));
+    }
+
+    for (int round = 0; round < 50; ++round) {
+        uint64_t first = id;
+        for (uint64_t i = 0; i < 500; ++i) {   // 100 levels per side
+            book.add_order(Order::Limit(id++, 1, Side::BUY, 1000 - i % 100, 10), &fills);
+            book.add_order(Order::Limit(id++, 1, Side::SELL, 1001 + i % 100, 10), &fills);
+        }
+        for (uint64_t k = first; k < id; k += 3)
+            book.cancel_order(k);
+        for (uint64_t i = 0; i < 500; i += 7)   // reprice some asks one tick up
+            book.modify_order(first + 2 * i + 1, 1002 + i % 100, 5, &fills);
+
+        fills.clear();
+        book.add_order(Order::Market(id++, 1, Side::BUY, 2000), &fills);
+        fills.clear();
+        book.add_order(Order::Limit(id++, 1, Side::SELL, 990, 3000), &fills);   // crosses, rests
+        fills.clear();
+
+        for (uint64_t k = first; k < id; ++k)
+            book.cancel_order(k);
+    }
+
+    assert(g_heap_allocations.load() == before);
+    assert(book.total_orders() == 200);
+    assert(book.best_bid_price() == 800 && book.best_ask_price() == 1200);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Lock-free id filter
+// ============================================================
+
+template <typename LP, typename LV>
+void test_id_filter_rejects_match_locked_path() {
+    std::cout << "[TEST] Duplicate and Unknown Ids Rejected\n";
+    OrderBook<LP, LV> book;
+    const uint64_t N = 5000;   // enough to grow the registry a few times
+
+    for (uint64_t id = 1; id <= N; ++id)
+        assert(book.add_order(Order::Limit(id, 1, Side::BUY, 100 - id % 50, 10)));
+    for (uint64_t id = 1; id <= N; ++id)
+        assert(!book.add_order(Order::Limit(id, 1, Side::SELL, 500, 10)));
+    assert(!book.cancel_order(N + 1));
+    assert(!book.modify_order(N + 1, 100, 5));
+
+    for (uint64_t id = 1; id <= N; id += 2) {
+        assert(book.cancel_order(id));
+        assert(!book.cancel_order(id));
+    }
+    assert(book.total_orders() == N / 2);
+    assert(book.modify_order(2, 99, 5));
+
+    // An id is free again once its order has traded away
+    assert(book.add_order(Order::Limit(7001, 1, Side::SELL, 200, 5)));
+    assert(book.add_order(Order::Market(7002, 1, Side::BUY, 5)));
+    assert(!book.cancel_order(7001));
+    assert(book.add_order(Order::Limit(7001, 1, Side::SELL, 200, 5)));
+    assert(book.cancel_order(7001));
+
+    // Ids that collide with the registry's sentinels still work
+    for (uint64_t id : {uint64_t{0}, UINT64_MAX}) {
+        assert(book.add_order(Order::Limit(id, 1, Side::SELL, 300, 1)));
+        assert(!book.add_order(Order::Limit(id, 1, Side::SELL, 300, 1)));
+        assert(book.cancel_order(id));
+        assert(!book.cancel_order(id));
+    }
+
+    std::cout << "  PASSED\n";
+}
+
+void test_order_id_registry_concurrent_readers() {
+    std::cout << "[TEST] Id Registry Readers Never Contradict the Writer\n";
+    OrderIdRegistry reg(16);
+    std::set<uint64_t> live;
+    auto insert = [&](uint64_t id) {
+        if (reg.full())
+            reg.rebuild(live.size() * 2, [&](auto&& add) { for (uint64_t x : live) add(x); });
+        reg.insert(id);
+        live.insert(id);
+    };
+    for (uint64_t id = 1; id <= 100; ++id)   // resting for the whole test
+        insert(id);
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> checks{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                for (uint64_t id = 1; id <= 100; ++id)
+                    assert(!reg.surely_absent(id));
+                for (uint64_t id = 1'000'000; id < 1'000'100; ++id)   // never inserted
+                    assert(!reg.surely_present(id));
+                checks.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Churn (with rebuilds) while the readers run
+    for (uint64_t id = 1000; id < 60000; ++id) {
+        insert(id);
+        if (id % 3 != 0) {
+            reg.erase(id);
+            live.erase(id);
+        }
+    }
+    while (checks.load(std::memory_order_relaxed) < 10)
+        std::this_thread::yield();
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+
+    for (uint64_t x : live)
+        assert(reg.surely_present(x) || !reg.surely_absent(x));
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Order index
+// ============================================================
+
+void test_order_index() {
+    std::cout << "[TEST] Order Index Matches unordered_map\n";
+    std::vector<OrderNode> nodes(64);
+    auto node_for = [&](uint64_t id) { return &nodes[id % nodes.size()]; };
+
+    OrderIndex idx(64);   // small window so the test slides it constantly
+    std::unordered_map<uint64_t, OrderNode*> ref;
+    std::mt19937_64 rng(7);
+    uint64_t next_id = 1;
+
+    auto check = [&](uint64_t id) {
+        auto it = ref.find(id);
+        assert(idx.find(id) == (it == ref.end() ? nullptr : it->second));
+    };
+
+    for (int step = 0; step < 200000; ++step) {
+        int op = static_cast<int>(rng() % 10);
+        if (op < 5) {
+            // Mostly increasing ids, with stragglers, far jumps and random ids
+            uint64_t id = next_id++;
+            int kind = static_cast<int>(rng() % 100);
+            if (kind == 0)      id = rng();
+            else if (kind == 1) id = next_id + 1000 + rng() % 5000;
+            else if (kind < 5 && next_id > 200) id = next_id - 1 - rng() % 200;
+            bool fresh = !ref.count(id);
+            assert(idx.insert(id, node_for(id)) == fresh);
+            if (fresh) ref[id] = node_for(id);
+        } else if (op < 9 && !ref.empty()) {
+            // Erase a live id (ids near the top are most common)
+            auto it = ref.begin();
+            std::advance(it, rng() % std::min<size_t>(ref.size(), 8));
+            uint64_t id = it->first;
+            assert(idx.extract(id) == it->second);
+            ref.erase(it);
+            assert(idx.extract(id) == nullptr);
+        } else {
+            check(rng() % (next_id + 10));
+        }
+        assert(idx.size() == ref.size());
+    }
+    for (const auto& [id, node] : ref)
+        assert(idx.find(id) == node);
+
+    // Jump far above a non-empty window, then walk up to it
+    OrderIndex jump(16);
+    assert(jump.insert(1, &nodes[1]));
+    assert(jump.insert(1000, &nodes[2]));
+    assert(!jump.insert(1000, &nodes[3]));
+    for (uint64_t id = 2; id < 1000; ++id)
+        assert(jump.insert(id, &nodes[0]));
+    assert(jump.find(1000) == &nodes[2] && jump.find(1) == &nodes[1]);
+    assert(!jump.insert(1000, &nodes[3]));
+    assert(jump.size() == 1000);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Thread placement
+// ============================================================
+
+void test_thread_placement() {
+    std::cout << "[TEST] Thread Placement Plans\n";
+    // 2 sockets × 2 cores × 2 threads, Linux-style numbering: siblings are n and n + 4
+    CpuTopology topo({{0, 0, 0, 0}, {1, 1, 0, 0}, {2, 0, 1, 1}, {3, 1, 1, 1},
+                      {4, 0, 0, 0}, {5, 1, 0, 0}, {6, 0, 1, 1}, {7, 1, 1, 1}});
+    assert(topo.sockets() == 2 && topo.nodes() == 2);
+
+    using V = std::vector<int>;
+    assert(plan_threads(topo, Placement::NONE,    3) == V({-1, -1, -1}));
+    assert(plan_threads(topo, Placement::COMPACT, 4) == V({0, 1, 2, 3}));
+    assert(plan_threads(topo, Placement::SMT,     4) == V({0, 4, 1, 5}));      // core pairs
+    assert(plan_threads(topo, Placement::SOCKET,  5) == V({0, 1, 4, 5, 2}));   // socket 0 first
+    assert(plan_threads(topo, Placement::CROSS,   4) == V({0, 2, 1, 3}));      // alternate sockets
+    assert(plan_threads(topo, Placement::COMPACT, 10)[9] == 1);                // wraps around
+
+    Placement p;
+    assert(parse_placement("socket", p) && p == Placement::SOCKET);
+    assert(!parse_placement("numa", p));
+
+    // Pinning to a CPU we may run on succeeds and sticks
+    CpuTopology here = CpuTopology::detect();
+    int cpu = here.cpus().back().cpu;
+    int seen = run_on_cpu(cpu, [] { return current_cpu(); });
+    assert(seen == cpu || seen == -1);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Work stealing
+// ============================================================
+
+void test_work_stealing() {
+    std::cout << "[TEST] Work Stealing Runs Every Task Once\n";
+    // Costs dealt largest first into shares [0,2) [2,4) [4,7)
+    std::vector<int> cost = {5, 1, 9, 3, 7, 2, 8};
+    assert(deal_by_cost(cost, 3) == std::vector<size_t>({2, 0, 6, 3, 4, 5, 1}));
+    assert(deal_by_cost(cost, 1) == std::vector<size_t>({2, 6, 4, 0, 3, 5, 1}));
+
+    // Worker 0's share is all heavy tasks, so the others run dry and steal
+    const size_t n = 2000;
+    std::vector<std::atomic<int>> runs(n);
+    std::vector<int> cpus(4, -1);
+    std::vector<StealStats> stats = run_work_stealing(n, cpus, [&](size_t task, size_t) {
+        if (task < n / 4) {
+            volatile uint64_t x = 0;
+            for (int i = 0; i < 20000; ++i) x = x + i;
+        }
+        runs[task].fetch_add(1, std::memory_order_relaxed);
+    });
+    assert(stats.size() == 4);
+    size_t done = 0;
+    for (const StealStats& s : stats) done += s.tasks;
+    assert(done == n);
+    for (auto& r : runs) assert(r.load() == 1);
+
+    // Fewer tasks than workers, and none at all
+    std::atomic<int> calls{0};
+    run_work_stealing(2, cpus, [&](size_t, size_t) { calls.fetch_add(1); });
+    run_work_stealing(0, cpus, [&](size_t, size_t) { calls.fetch_add(1); });
+    assert(calls.load() == 2);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Command journal
+// ============================================================
+
+template <typename LP, typename LV>
+void test_journal_replay_round_trip() {
+    std::cout << "[TEST] Journal Replay Rebuilds the Same Book\n";
+    std::string path = (std::filesystem::temp_directory_path()
+                        / "orderbook_test_journal.bin").string();
+
+    OrderBook<LP, LV> book;
+    {
+        JournalWriter::Options opts;
+        opts.buffer_records = 16;   // force plenty of buffer hand-offs
+        JournalWriter journal(path, opts);
+        book.set_journal(&journal);
+
+        uint64_t id = 1;
+        for (int i = 0; i < 500; ++i) {
+            Side side = (i % 2) ? Side::SELL : Side::BUY;
+            uint64_t price = side == Side::BUY ? 90 + i % 9 : 96 + i % 9;
+            book.add_order(Order::Limit(id++, 1, side, price, 1 + i % 7));
+            if (i % 4 == 3) book.cancel_order(id - 3);
+            if (i % 60 == 59) book.add_order(Order::Market(id++, 1, Side::SELL, 15));
+            if (i % 70 == 69) book.add_order(Order::Iceberg(id++, 1, Side::SELL, 97, 30, 4));
+            if (i % 5 == 2) book.modify_order(id - 2, side == Side::BUY ? 96 : 94, 3);
+            if (i % 90 == 89)
+                book.add_order(Order::Limit(id++, 1, Side::BUY, 99, 9).with_tif(TimeInForce::IOC));
+        }
+        assert(!book.add_order(Order::Limit(1, 1, Side::BUY, 90, 1)));   // dup: not journaled
+        assert(!book.cancel_order(999999));                              // miss: not journaled
+
+        book.set_journal(nullptr);
+        journal.flush();
+    }
+
+    JournalReader reader(path);
+    OrderBook<LP, LV> rebuilt;
+    assert(replay(reader.begin(), reader.end(), rebuilt) == reader.size());
+
+    BookDepth a = book.depth(1000), b = rebuilt.depth(1000);
+    assert(rebuilt.total_orders() == book.total_orders());
+    assert(a.bids.size() == b.bids.size() && a.asks.size() == b.asks.size());
+    for (size_t i = 0; i < a.bids.size(); ++i)
+        assert(a.bids[i].price == b.bids[i].price && a.bids[i].quantity == b.bids[i].quantity
+               && a.bids[i].order_count == b.bids[i].order_count);
+    for (size_t i = 0; i < a.asks.size(); ++i)
+        assert(a.asks[i].price == b.asks[i].price && a.asks[i].quantity == b.asks[i].quantity
+               && a.asks[i].order_count == b.asks[i].order_count);
+
+    std::filesystem::remove(path);
+    std::cout << "  PASSED\n";
+}
+
+void test_journal_io_errors() {
+    std::cout << "[TEST] Journal I/O Errors Reach the Caller\n";
+    std::string path = (std::filesystem::temp_directory_path()
+                        / "orderbook_test_journal_err.bin").string();
+
+    {
+        std::ofstream junk(path, std::ios::binary);
+        junk << "definitely not a journal file";
+    }
+    bool threw = false;
+    try { JournalReader reader(path); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+#if defined(__unix__)
+    // Cap the file size so the flusher thread's write() fails with EFBIG
+    struct rlimit old_limit;
+    getrlimit(RLIMIT_FSIZE, &old_limit);
+    auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+    struct rlimit cap = old_limit;
+    cap.rlim_cur = 4096;
+    setrlimit(RLIMIT_FSIZE, &cap);
+    {
+        JournalWriter::Options opts;
+        opts.buffer_records = 16;
+        JournalWriter journal(path, opts);
+
+        threw = false;
+        try {
+            for (uint64_t i = 1; i <= 1000; ++i)
+                journal.append(make_cancel_record(1, i));
+            journal.flush();
+        } catch (const std::runtime_error&) { threw = true; }
+        assert(threw);
+
+        threw = false;   // the journal stays failed
+        try { journal.append(make_cancel_record(1, 1)); } catch (const std::runtime_error&) { threw = true; }
+        assert(threw);
+    }   // destructor must not throw
+    setrlimit(RLIMIT_FSIZE, &old_limit);
+    std::signal(SIGXFSZ, old_handler);
+#endif
+
+    std::filesystem::remove(path);
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Snapshot and load
+// ============================================================
+
+template <typename Book>
+bool same_depth(const Book& x, const Book& y) {
+    BookDepth a = x.depth(100000), b = y.depth(100000);
+    auto same = [](const std::vector<LevelInfo>& p, const std::vector<LevelInfo>& q) {
+        if (p.size() != q.size()) return false;
+        for (size_t i = 0; i < p.size(); ++i)
+            if (p[i].price != q[i].price || p[i].quantity != q[i].quantity
+                || p[i].order_count != q[i].order_count)
+                return false;
+        return true;
+    };
+    return same(a.bids, b.bids) && same(a.asks, b.asks) && x.total_orders() == y.total_orders();
+}
+
+template <typename LP, typename LV>
+void test_snapshot_load_round_trip() {
+    std::cout << "[TEST] Snapshot Load Rebuilds Queues, Icebergs and Exec Seq\n";
+    OrderBook<LP, LV> book;
+    uint64_t id = 1;
+    for (int i = 0; i < 2000; ++i) {
+        Side side = (i % 2) ? Side::SELL : Side::BUY;
+        uint64_t price = side == Side::BUY ? 90 + i % 9 : 96 + i % 9;
+        book.add_order(Order::Limit(id++, 1 + i % 3, side, price, 1 + i % 7));
+        if (i % 4 == 3) book.cancel_order(id - 3);
+        if (i % 50 == 49) book.add_order(Order::Market(id++, 1, Side::SELL, 15));
+        if (i % 70 == 69) book.add_order(Order::Iceberg(id++, 1, Side::SELL, 97, 30, 4));
+        if (i % 5 == 2) book.modify_order(id - 2, side == Side::BUY ? 95 : 97, 3);
+    }
+    // Leave an iceberg part-way through its visible slice
+    book.add_order(Order::Iceberg(id++, 1, Side::BUY, 95, 20, 6));
+    book.add_order(Order::Market(id++, 1, Side::SELL, book.top_of_book().bid_qty - 2));
+
+    BookSnapshot snap;
+    book.snapshot(snap);
+    assert(snap.orders.size() == book.total_orders());
+
+    OrderBook<LP, LV> copy;
+    assert(copy.load(snap));
+    assert(same_depth(book, copy));
+    TopOfBook ta = book.top_of_book(), tb = copy.top_of_book();
+    assert(ta.bid_price == tb.bid_price && ta.bid_qty == tb.bid_qty);
+    assert(ta.ask_price == tb.ask_price && ta.ask_qty == tb.ask_qty);
+    assert(!copy.load(snap));   // only into an empty book
+
+    // Same queues: sweeping both sides gives identical fills, iceberg
+    // refills included, and execution seqs carry on
+    for (Side side : {Side::BUY, Side::SELL}) {
+        ExecutionRing fa(8192), fb(8192);
+        book.add_order(Order::Market(id, 1, side, UINT32_MAX), &fa);
+        copy.add_order(Order::Market(id, 1, side, UINT32_MAX), &fb);
+        ++id;
+        assert(fa.size() > 0 && fa.size() == fb.size());
+        for (size_t i = 0; i < fa.size(); ++i)
+            assert(fa[i].maker_id == fb[i].maker_id && fa[i].price == fb[i].price
+                   && fa[i].quantity == fb[i].quantity && fa[i].seq == fb[i].seq);
+    }
+    assert(copy.total_orders() == 0);
+
+    // File round trip, and a reused snapshot doesn't allocate
+    OrderBook<LP, LV> src;
+    for (uint64_t k = 1; k <= 300; ++k)
+        src.add_order(Order::Limit(k, 1, k % 2 ? Side::BUY : Side::SELL,
+                                   k % 2 ? 100 - k % 10 : 101 + k % 10, k));
+    src.snapshot(snap);
+    size_t before = g_heap_allocations.load();
+    src.snapshot(snap);
+    assert(g_heap_allocations.load() == before);
+
+    std::string path = (std::filesystem::temp_directory_path()
+                        / "orderbook_test_snapshot.bin").string();
+    snap.save(path);
+    OrderBook<LP, LV> restored;
+    assert(restored.load(BookSnapshot::read(path)));
+    assert(same_depth(src, restored));
+    for (uint64_t k = 1; k <= 300; ++k)
+        assert(restored.cancel_order(k));
+    std::filesystem::remove(path);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP, typename LV>
+void test_snapshot_load_rejects_bad_images() {
+    std::cout << "[TEST] Load Rejects Images a Book Can't Hold\n";
+    auto image = [](std::vector<SnapshotOrder> bids, std::vector<SnapshotOrder> asks) {
+        BookSnapshot s;
+        s.bid_orders = bids.size();
+        s.orders = bids;
+        s.orders.insert(s.orders.end(), asks.begin(), asks.end());
+        return s;
+    };
+    SnapshotOrder b1{1, 100, 1, 5, 0, 0}, b2{2, 99, 1, 5, 0, 0};
+    SnapshotOrder a1{3, 101, 1, 5, 0, 0}, a2{4, 102, 1, 5, 0, 0};
+
+    OrderBook<LP, LV> book;
+    auto rejected = [&book](const BookSnapshot& s) {
+        return !book.load(s) && book.total_orders() == 0
+            && book.total_bid_levels() == 0 && book.total_ask_levels() == 0;
+    };
+    assert(rejected(image({b2, b1}, {a1})));                       // bids worst first
+    assert(rejected(image({b1}, {a2, a1})));                       // asks worst first
+    assert(rejected(image({b1, b2}, {SnapshotOrder{3, 100, 1, 5, 0, 0}})));   // crossed
+    assert(rejected(image({b1, b2}, {a1, SnapshotOrder{2, 102, 1, 5, 0, 0}})));   // repeated id
+    assert(rejected(image({b1, SnapshotOrder{2, 99, 1, 0, 0, 0}}, {a1})));         // empty order
+    assert(rejected(image({b1, SnapshotOrder{2, 99, 1, 5, 0, 9}}, {a1})));         // reserve, no peak
+    assert(rejected(image({b1, SnapshotOrder{2, 99, 1, 5, 4, 9}}, {a1})));         // slice > peak
+    if constexpr (std::is_same_v<LV, TickLadder>)
+        assert(rejected(image({b1}, {SnapshotOrder{3, 1u << 20, 1, 5, 0, 0}})));  // off the ladder
+
+    assert(book.load(image({b1, b2}, {a1, a2})));
+    assert(book.total_orders() == 4);
+    assert(!book.add_order(Order::Limit(2, 1, Side::BUY, 98, 1)));   // loaded ids are live
+    assert(book.cancel_order(3));
+    assert(*book.best_ask_price() == 102);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Tick ladder backend
+// ============================================================
+
+template <typename LP>
+void test_ladder_rejects_out_of_band() {
+    std::cout << "[TEST] Ladder Rejects Out-of-Band Prices\n";
+    OrderBook<LP, TickLadder> book(LadderConfig{1000, 5, 100});  // [1000, 1495]
+
+    assert(book.add_order(Order::Limit(1, 1, Side::BUY, 1000, 10)));
+    assert(book.add_order(Order::Limit(2, 1, Side::SELL, 1495, 10)));
+
+    assert(book.add_order(Order::Limit(3, 1, Side::BUY, 995, 10)) == false);   // below base
+    assert(book.add_order(Order::Limit(4, 1, Side::SELL, 1500, 10)) == false); // past last tick
+    assert(book.add_order(Order::Limit(5, 1, Side::BUY, 1002, 10)) == false);  // off tick
+
+    assert(book.total_orders() == 2);
+    assert(book.best_bid_price() == 1000);
+    assert(book.best_ask_price() == 1495);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LP>
+void test_ladder_best_price_search() {
+    std::cout << "[TEST] Ladder Best Price Search Across Bitmap Words\n";
+    OrderBook<LP, TickLadder> book(LadderConfig{0, 1, 1000});
+
+    // Levels spread over several 64-bit bitmap words
+    book.add_order(Order::Limit(1, 1, Side::BUY, 3, 10));
+    book.add_order(Order::Limit(2, 1, Side::BUY, 130, 10));
+    book.add_order(Order::Limit(3, 1, Side::BUY, 700, 10));
+    book.add_order(Order::Limit(4, 1, Side::SELL, 800, 10));
+    book.add_order(Order::Limit(5, 1, Side::SELL, 871, 10));
+    book.add_order(Order::Limit(6, 1, Side::SELL, 999, 10));
+
+    assert(book.best_bid_price() == 700);
+    assert(book.best_ask_price() == 800);
+
+    book.cancel_order(3);
+    assert(book.best_bid_price() == 130);
+    book.cancel_order(2);
+    assert(book.best_bid_price() == 3);
+    book.cancel_order(1);
+    assert(book.best_bid_price() == std::nullopt);
+
+    // Market buy consumes 800 and 871, leaves 999 as best ask
+    book.add_order(Order::Market(7, 1, Side::BUY, 20));
+    assert(book.best_ask_price() == 999);
+    assert(book.total_ask_levels() == 1);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Sharded engine
+// ============================================================
+
+void test_spsc_queue() {
+    std::cout << "[TEST] SPSC Queue Ordering Across Threads\n";
+    SpscQueue<uint64_t> q(8);
+    const uint64_t N = 100000;
+
+    assert(q.capacity() == 8);
+
+    std::thread producer([&]() {
+        for (uint64_t i = 1; i <= N; ++i)
+            while (!q.try_push(i)) std::this_thread::yield();
+    });
+
+    uint64_t expected = 1, v;
+    while (expected <= N) {
+        if (q.try_pop(v)) {
+            assert(v == expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    assert(q.empty());
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LV>
+void test_matching_engine_sharding() {
+    std::cout << "[TEST] Matching Engine Routes by Symbol\n";
+    EngineConfig cfg;
+    cfg.num_shards    = 3;
+    cfg.num_producers = 2;
+    cfg.queue_capacity = 16;   // small, so producers hit backpressure
+    cfg.book.max_orders = 64;
+    cfg.symbols = {0, 1, 2};   // built up front; 3..7 on first add
+    MatchingEngine<LV> engine(cfg);
+    assert(engine.book(2) && engine.book(2)->total_orders() == 0 && !engine.book(3));
+
+    const uint32_t SYMBOLS = 8;
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < 2; ++p) {
+        producers.emplace_back([&, p]() {
+            for (uint32_t sym = 0; sym < SYMBOLS; ++sym) {
+                uint64_t base = (p + 1) * 1000 + sym * 10;
+                Side side = p == 0 ? Side::BUY : Side::SELL;
+                uint64_t price = p == 0 ? 100 : 110;
+                for (uint64_t k = 0; k < 5; ++k)
+                    engine.add_order(p, Order::Limit(base + k, sym, side, price + k % 2, 10));
+                engine.cancel_order(p, sym, base);         // known id
+                engine.cancel_order(p, sym, base + 999);   // unknown id
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+    engine.flush();
+
+    uint64_t processed = 0, rejected = 0;
+    for (size_t s = 0; s < engine.num_shards(); ++s) {
+        processed += engine.stats(s).processed;
+        rejected  += engine.stats(s).rejected;
+    }
+    assert(processed == 2 * SYMBOLS * 7);
+    assert(rejected == 2 * SYMBOLS);
+
+    for (uint32_t sym = 0; sym < SYMBOLS; ++sym) {
+        const auto* book = engine.book(sym);
+        assert(book != nullptr);
+        assert(book->total_orders() == 8);
+        assert(book->best_bid_price() == 101);
+        assert(book->best_ask_price() == 110);
+    }
+
+    // A cancel to a symbol with no book is rejected without building one
+    engine.cancel_order(0, 1000, 1);
+    engine.flush();
+    assert(!engine.book(1000));
+    rejected = 0;
+    for (size_t s = 0; s < engine.num_shards(); ++s)
+        rejected += engine.stats(s).rejected;
+    assert(rejected == 2 * SYMBOLS + 1);
+
+    // Cross one symbol after a flush; other symbols are untouched
+    engine.add_order(0, Order::Limit(9999, 3, Side::BUY, 111, 100));
+    engine.stop();
+    assert(engine.book(3)->best_ask_price() == std::nullopt);
+    assert(engine.book(3)->best_bid_price() == 111);
+    assert(engine.book(4)->best_ask_price() == 110);
+
+    std::cout << "  PASSED\n";
+}
+
+// Idle shards sleep after idle_spins empty polls, using (almost) no CPU,
+// and the next push wakes them.
+template <typename LV>
+void test_matching_engine_idle_sleeps() {
+    std::cout << "[TEST] Idle Matching Engine Shards Sleep and Wake\n";
+    EngineConfig cfg;
+    cfg.num_shards = 2;
+    cfg.idle_spins = 64;
+    MatchingEngine<LV> engine(cfg);
+
+    for (int round = 0; round < 3; ++round) {
+        std::clock_t c0 = std::clock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        double cpu_ms = 1000.0 * static_cast<double>(std::clock() - c0) / CLOCKS_PER_SEC;
+        assert(cpu_ms < 50);   // two polling shards would burn ~200 ms
+
+        for (uint32_t sym = 0; sym < 2; ++sym)
+            engine.add_order(0, Order::Limit(100 * round + sym + 1, sym, Side::BUY, 100, 1));
+        engine.flush();
+    }
+    engine.stop();
+    assert(engine.book(0)->total_orders() == 3 && engine.book(1)->total_orders() == 3);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Async front-end
+// ============================================================
+
+template <typename LV>
+void test_async_book_results() {
+    std::cout << "[TEST] Async Book Completes Each Request With Its Result\n";
+    OrderBook<MutexPolicy, LV> book;
+    AsyncConfig cfg;
+    cfg.queue_capacity = 4;   // small, so submit() hits backpressure
+    AsyncBook<MutexPolicy, LV> async(book, cfg);
+
+    AsyncOp ops[6];
+    async.submit(0, BookCommand::Add(Order::Limit(1, 1, Side::SELL, 105, 10)), &ops[0]);
+    async.submit(0, BookCommand::Add(Order::Limit(2, 1, Side::BUY, 106, 4)), &ops[1]);
+    async.submit(0, BookCommand::Add(Order::Limit(1, 1, Side::BUY, 90, 1)), &ops[2]);
+    async.submit(0, BookCommand::Cancel(77), &ops[3]);
+    async.submit(0, BookCommand::Modify(1, 105, 2), &ops[4]);
+    async.submit(0, BookCommand::Add(Order::Market(3, 1, Side::BUY, 5)), &ops[5]);
+    async.submit(0, BookCommand::Add(Order::Limit(4, 1, Side::BUY, 100, 1)));   // no op
+
+    const BookResult& taker = ops[1].wait();
+    assert(taker.accepted && taker.fills == 1 && taker.filled_qty == 4);
+    assert(!ops[2].wait().accepted && !ops[3].wait().accepted);
+    assert(ops[4].wait().accepted);
+    assert(ops[5].wait().filled_qty == 2);   // 6 left of 1, amended to 2
+    assert(ops[0].ready() && ops[0].result().accepted);
+
+    async.flush();
+    assert(async.processed() == 7);
+    assert(book.total_orders() == 1 && book.best_bid_price() == 100);
+
+    // An op can be reused once it's complete
+    async.submit(0, BookCommand::Cancel(4), &ops[0]);
+    assert(ops[0].wait().accepted);
+    async.stop();
+    assert(book.total_orders() == 0);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LV>
+void test_async_book_pipelined_clients() {
+    std::cout << "[TEST] Async Book Keeps Per-Client Order Under Pipelining\n";
+    OrderBook<MutexPolicy, LV> book;
+    AsyncConfig cfg;
+    cfg.num_clients = 4;
+    cfg.queue_capacity = 64;
+    cfg.max_batch = 16;
+    AsyncBook<MutexPolicy, LV> async(book, cfg);
+
+    // Each client adds orders and cancels each even id 17 requests later,
+    // with up to 32 requests in flight; orders never cross, so every
+    // request succeeds
+    const uint64_t N = 4000;
+    const size_t WINDOW = 32;
+    std::vector<std::thread> clients;
+    std::atomic<uint64_t> failures{0};
+    for (size_t c = 0; c < 4; ++c) {
+        clients.emplace_back([&, c]() {
+            std::vector<AsyncOp> window(WINDOW);
+            uint64_t base = (c + 1) * 1'000'000;
+            Side side = c % 2 ? Side::SELL : Side::BUY;
+            uint64_t price = c % 2 ? 200 + c : 100 - c;
+            for (uint64_t i = 0; i < N; ++i) {
+                AsyncOp& op = window[i % WINDOW];
+                if (i >= WINDOW && !op.wait().accepted)
+                    failures.fetch_add(1);
+                BookCommand cmd = i % 2 == 0 || i < 17
+                    ? BookCommand::Add(Order::Limit(base + i, 1, side, price, 1))
+                    : BookCommand::Cancel(base + i - 17);   // an even id, still in flight
+                async.submit(c, cmd, &op);
+            }
+            for (AsyncOp& op : window)
+                if (!op.wait().accepted) failures.fetch_add(1);
+        });
+    }
+    for (auto& t : clients) t.join();
+    async.stop();
+
+    assert(failures.load() == 0);
+    assert(async.processed() == 4 * N);
+    assert(book.total_orders() == 4 * 16);   // odd ids below 17, last 8 even ids
+    assert(async.batches() <= async.processed());
+    std::cout << "  PASSED\n";
+}
+
+// The drain thread sleeps when nothing is queued and a submit wakes it.
+template <typename LV>
+void test_async_book_idle_sleeps() {
+    std::cout << "[TEST] Idle Async Drain Thread Sleeps and Wakes\n";
+    OrderBook<MutexPolicy, LV> book;
+    AsyncConfig cfg;
+    cfg.idle_spins = 64;
+    AsyncBook<MutexPolicy, LV> async(book, cfg);
+
+    for (uint64_t round = 0; round < 3; ++round) {
+        std::clock_t c0 = std::clock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        double cpu_ms = 1000.0 * static_cast<double>(std::clock() - c0) / CLOCKS_PER_SEC;
+        assert(cpu_ms < 25);   // a polling drain thread would burn ~100 ms
+
+        AsyncOp op;
+        async.submit(0, BookCommand::Add(Order::Limit(round + 1, 1, Side::SELL, 101, 1)), &op);
+        assert(op.wait().accepted);
+    }
+    async.stop();
+    assert(book.total_orders() == 3);
+
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// 새 테스트: Book views
+// ============================================================
+
+template <typename LP, typename LV>
+void test_book_view() {
+    std::cout << "[TEST] Book View Copies Levels And Orders\n";
+    OrderBook<LP, LV> book;
+    BookView v;
+    book.view(v);
+    assert(v.bids.empty() && v.asks.empty() && v.orders.empty());
+    assert(v.vwap(Side::BUY, 10) == 0.0);
+
+    book.add_order(Order::Limit(1, 1, Side::BUY, 100, 10));
+    book.add_order(Order::Limit(2, 1, Side::BUY, 100, 5));
+    book.add_order(Order::Limit(3, 1, Side::BUY, 98, 20));
+    book.add_order(Order::Iceberg(4, 1, Side::SELL, 103, 40, 10));
+    book.add_order(Order::Limit(5, 1, Side::SELL, 101, 6));
+    book.add_order(Order::Market(6, 1, Side::SELL, 2));   // trades 2 of id 1
+
+    book.view(v);
+    BookDepth d = book.depth(10);
+    assert(v.seq == d.seq && v.exec_seq == 1);
+    assert(v.bids.size() == 2 && v.asks.size() == 2 && v.orders.size() == 5);
+    assert(v.bids[0].price == 100 && v.bids[0].quantity == 13 && v.bids[0].count == 2);
+    assert(v.bids[1].price == 98 && v.asks[0].price == 101 && v.asks[1].price == 103);
+    const ViewOrder* o = v.orders_begin(v.bids[0]);
+    assert(o[0].id == 1 && o[0].visible == 8 && o[1].id == 2);
+    assert(v.orders_end(v.bids[0]) == o + 2);
+    const ViewOrder& ice = *v.orders_begin(v.asks[1]);
+    assert(ice.id == 4 && ice.visible == 10 && ice.reserve == 30);
+
+    uint64_t filled = 0;
+    assert(v.vwap(Side::SELL, 16, &filled) == (6.0 * 101 + 10.0 * 103) / 16 && filled == 16);
+    v.vwap(Side::SELL, 100, &filled);
+    assert(filled == 16);
+    assert(v.vwap(Side::BUY, 13) == 100.0);
+    assert(v.quantity_through(Side::BUY, 99) == 13 && v.quantity_through(Side::BUY, 98) == 33);
+    assert(v.quantity_through(Side::SELL, 102) == 6 && v.quantity_through(Side::SELL, 100) == 0);
+
+    // Top level only; reusing the view keeps its storage
+    const ViewOrder* storage = v.orders.data();
+    book.view(v, 1);
+    assert(v.bids.size() == 1 && v.asks.size() == 1 && v.orders.size() == 3);
+    assert(v.orders.data() == storage);
+    assert(v.orders_begin(v.asks[0])->id == 5);
+
+    std::cout << "  PASSED\n";
+}
+
+template <typename LV>
+void test_book_views_reclaim() {
+    std::cout << "[TEST] Book Views Keep A Pinned View Until Its Reader Leaves\n";
+    OrderBook<MutexPolicy, LV> book;
+    ViewConfig cfg;
+    cfg.max_readers = 2;
+    BookViews<MutexPolicy, LV> views(book, cfg);
+    assert(views.published() == 1 && views.allocated() == 1);
+
+    book.add_order(Order::Limit(1, 1, Side::BUY, 100, 10));
+    {
+        auto pinned = views.read(0);
+        assert(pinned->bids.empty());   // published before the add
+        const BookView* held = &*pinned;
+
+        // Republishing retires the pinned view but must not reuse it
+        for (int i = 0; i < 5; ++i) {
+            book.add_order(Order::Limit(10 + i, 1, Side::SELL, 200 + i, 1));
+            views.publish();
+            auto fresh = views.read(1);
+            assert(&*fresh != held && fresh->asks.size() == static_cast<size_t>(i + 1));
+        }
+        assert(pinned->bids.empty() && pinned->asks.empty());
+        assert(views.retired() >= 1);
+    }
+
+    // Reader 0 has left, so everything retired comes back
+    assert(views.reclaim() >= 1 && views.retired() == 0);
+    size_t allocated = views.allocated();
+    for (int i = 0; i < 20; ++i) {
+        views.publish();
+        auto v = views.read(0);
+        assert(v->bids.size() == 1 && v->asks.size() == 5);
+    }
+    assert(views.allocated() == allocated);   // steady state reuses views
+    assert(views.published() == 26);
+    std::cout << "  PASSED\n";
+}
+
+template <typename LV>
+void test_book_views_concurrent_readers() {
+    std::cout << "[TEST] Book View Readers See Consistent Books While Writing\n";
+    OrderBook<NullLockPolicy, LV> book;   // only the writer thread touches it
+    ViewConfig cfg;
+    cfg.max_readers = 3;
+    BookViews<NullLockPolicy, LV> views(book, cfg);
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0}, reads{0};
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r]() {
+            uint64_t last_seq = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                auto v = views.read(r);
+                bool ok = v->seq >= last_seq;
+                last_seq = v->seq;
+                size_t orders = 0;
+                for (Side side : {Side::BUY, Side::SELL}) {
+                    const auto& levels = v->levels(side);
+                    for (size_t i = 0; i < levels.size(); ++i) {
+                        const ViewLevel& l = levels[i];
+                        if (i && (side == Side::BUY ? l.price >= levels[i - 1].price
+                                                    : l.price <= levels[i - 1].price))
+                            ok = false;
+                        uint64_t q = 0;
+                        for (const ViewOrder* o = v->orders_begin(l); o != v->orders_end(l); ++o)
+                            q += o->visible;
+                        ok &= q == l.quantity && l.count > 0 && l.first == orders;
+                        orders += l.count;
+                    }
+                }
+                ok &= orders == v->orders.size();
+                if (!v->bids.empty() && !v->asks.empty())
+                    ok &= v->bids[0].price < v->asks[0].price;
+                if (!ok) failures.fetch_add(1);
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::mt19937_64 rng(24);
+    std::vector<uint64_t> ids;
+    for (uint64_t id = 1; id <= 20000; ++id) {
+        uint64_t r = rng() % 100;
+        if (r < 55 || ids.empty()) {
+            Side side = (rng() & 1) ? Side::BUY : Side::SELL;
+            book.add_order(Order::Limit(id, 1, side, 1000 + rng() % 40, 1 + rng() % 20));
+            ids.push_back(id);
+        } else if (r < 90) {
+            size_t k = rng() % ids.size();
+            book.cancel_order(ids[k]);
+            ids[k] = ids.back();
+            ids.pop_back();
+        } else {
+            book.add_order(Order::Market(id, 1, (rng() & 1) ? Side::BUY : Side::SELL, rng() % 50));
+        }
+        if (id % 16 == 0)
+            views.publish();
+        if (id % 1024 == 0)
+            std::this_thread::yield();   // let readers in on a single core
+    }
+    while (reads.load() < 100)
+        std::this_thread::yield();
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+
+    assert(failures.load() == 0);
+    assert(views.allocated() <= views.published());
+    std::cout << "  PASSED\n";
+}
+
+// ============================================================
+// Run all tests for a given policy
+// ============================================================
+
+template <typename LP, typename LV>
+void run_all_tests(const std::string& label) {
+    std::cout << "========================================\n";
+    std::cout << "Testing: " << label << "\n";
+    std::cout << "========================================\n\n";
+
+    test_add_limit_order<LP, LV>();
+    test_price_time_priority<LP, LV>();
+    test_cancel_order<LP, LV>();
+    test_market_order_matching<LP, LV>();
+    test_partial_fill<LP, LV>();
+    test_multi_level_cross<LP, LV>();
+    test_cancel_nonexistent<LP, LV>();
+    test_empty_book_queries<LP, LV>();
+    test_resting_quantity_limit<LP, LV>();
+    test_cancel_updates_best_price<LP, LV>();
+    test_batch_add_cancel<LP, LV>();
+    test_apply_batch_mixed<LP, LV>();
+    test_top_of_book<LP, LV>();
+    test_depth_snapshot<LP, LV>();
+    test_quantity_through<LP, LV>();
+    test_level_delta_feed<LP, LV>();
+    test_ioc_and_fok<LP, LV>();
+    test_post_only<LP, LV>();
+    test_iceberg_replenish<LP, LV>();
+    test_modify_keeps_or_resets_priority<LP, LV>();
+    test_modify_reprice<LP, LV>();
+    test_journal_replay_round_trip<LP, LV>();
+    test_snapshot_load_round_trip<LP, LV>();
+    test_snapshot_load_rejects_bad_images<LP, LV>();
+    test_book_view<LP, LV>();
+    test_book_stats<LP, LV>();
+    test_reserved_book_does_not_allocate<LP, LV>();
+    test_id_filter_rejects_match_locked_path<LP, LV>();
+    if constexpr (!std::is_same_v<LP, NullLockPolicy>) {
+        test_concurrent_add_cancel<LP, LV>();
+        test_concurrent_top_of_book_never_torn<LP, LV>();
+    }
+    test_cancel_middle_of_level<LP, LV>();
+    test_marketable_limit_crosses<LP, LV>();
+    test_sell_sweeps_from_best_bid<LP, LV>();
+    test_deep_sweep_takes_whole_levels<LP, LV>();
+    test_execution_ring_overflow<LP, LV>();
+
+    if constexpr (std::is_same_v<LV, TickLadder>) {
+        test_ladder_rejects_out_of_band<LP>();
+        test_ladder_best_price_search<LP>();
+    }
+
+    std::cout << "\nAll " << label << " tests PASSED.\n\n";
+}
+
+int main() {
+    run_all_tests<MutexPolicy, MapLevels>("MutexPolicy / MapLevels");
+    run_all_tests<SharedMutexPolicy, MapLevels>("SharedMutexPolicy / MapLevels");
+    run_all_tests<MutexPolicy, TickLadder>("MutexPolicy / TickLadder");
+    run_all_tests<SharedMutexPolicy, TickLadder>("SharedMutexPolicy / TickLadder");
+    run_all_tests<SpinLockPolicy, MapLevels>("SpinLockPolicy / MapLevels");
+    run_all_tests<TicketLockPolicy, TickLadder>("TicketLockPolicy / TickLadder");
+    run_all_tests<AdaptiveLockPolicy, MapLevels>("AdaptiveLockPolicy / MapLevels");
+    run_all_tests<SeqLockPolicy, MapLevels>("SeqLockPolicy / MapLevels");
+    run_all_tests<SeqLockPolicy, TickLadder>("SeqLockPolicy / TickLadder");
+    run_all_tests<NullLockPolicy, MapLevels>("NullLockPolicy / MapLevels");
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: MatchingEngine\n";
+    std::cout << "========================================\n\n";
+    test_spsc_queue();
+    test_matching_engine_sharding<MapLevels>();
+    test_matching_engine_sharding<TickLadder>();
+    test_matching_engine_idle_sleeps<MapLevels>();
+    test_matching_engine_idle_sleeps<TickLadder>();
+    std::cout << "\n";
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: Journal I/O errors\n";
+    std::cout << "========================================\n\n";
+    test_journal_io_errors();
+    std::cout << "\n";
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: AsyncBook\n";
+    std::cout << "========================================\n\n";
+    test_async_book_results<MapLevels>();
+    test_async_book_results<TickLadder>();
+    test_async_book_pipelined_clients<MapLevels>();
+    test_async_book_pipelined_clients<TickLadder>();
+    test_async_book_idle_sleeps<MapLevels>();
+    test_async_book_idle_sleeps<TickLadder>();
+    std::cout << "\n";
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: BookViews\n";
+    std::cout << "========================================\n\n";
+    test_book_views_reclaim<MapLevels>();
+    test_book_views_reclaim<TickLadder>();
+    test_book_views_concurrent_readers<MapLevels>();
+    test_book_views_concurrent_readers<TickLadder>();
+    std::cout << "\n";
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: Instrumentation\n";
+    std::cout << "========================================\n\n";
+    test_log_histogram();
+    test_book_stats_many_threads();
+    std::cout << "\n";
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: Level sides and scan kernels\n";
+    std::cout << "========================================\n\n";
+    test_side_levels<MapLevels>();
+    test_side_levels<TickLadder>();
+    test_level_scan_kernels();
+    std::cout << "\n";
+
+    std::cout << "========================================\n";
+    std::cout << "Testing: Order index, id registry, thread placement and work stealing\n";
+    std::cout << "========================================\n\n";
+    test_order_index();
+    test_order_id_registry_concurrent_readers();
+    test_thread_placement();
+    test_work_stealing();
+    std::cout << "\n";
 
     std::cout << "========================================\n";
-    std::cout << "All tests PASSED for both policies.\n";
+    std::cout << "All tests PASSED for all policies and backends.\n";
     std::cout << "========================================\n";
 
     return 0;
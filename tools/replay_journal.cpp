@@ -0,0 +1,101 @@
+#include "order_book.h"
+#include "journal.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Rebuild a book from a journal written by OrderBook::set_journal() and
+// report how fast the commands were applied.
+//
+//   replay_journal FILE [--ladder BASE TICK LEVELS] [--strict]
+//
+// The book is single-threaded (NullLockPolicy) and MapLevels, which stores
+// any price, unless --ladder asks for a TickLadder with that band. Limit
+// prices the ladder can't store are reported apart from the other rejects,
+// with a warning, since they mean the band doesn't fit the journal.
+// Rejected commands are otherwise only counted: generated flows (bench_micro
+// --dump) include some by design. With --strict any rejection exits 2, for
+// checking a journal recorded by a live book, where every record was accepted.
+
+// Records whose price the book's levels can't store, so are rejected whatever
+// the book holds: limit adds and modifies outside the ladder band.
+template <typename Levels>
+static size_t out_of_band(const JournalReader& journal, const LadderConfig& cfg) {
+    typename Levels::template side<Side::BUY> band(cfg);
+    size_t n = 0;
+    for (const JournalRecord& r : journal) {
+        bool priced = r.kind == JournalRecord::MODIFY
+            || (r.kind == JournalRecord::ADD && static_cast<OrderType>(r.type) == OrderType::LIMIT);
+        n += priced && !band.accepts(r.price);
+    }
+    return n;
+}
+
+template <typename Levels>
+static int rebuild(const JournalReader& journal, const LadderConfig& cfg, bool strict) {
+    OrderBook<NullLockPolicy, Levels> book(cfg);
+
+    auto t0 = std::chrono::steady_clock::now();
+    size_t accepted = replay(journal.begin(), journal.end(), book);
+    auto t1 = std::chrono::steady_clock::now();
+
+    double secs = std::chrono::duration<double>(t1 - t0).count();
+    TopOfBook top = book.top_of_book();
+    size_t rejected = journal.size() - accepted;
+    size_t unstorable = out_of_band<Levels>(journal, cfg);
+
+    std::cout << "commands:    " << journal.size() << " (" << accepted << " accepted, "
+                                 << rejected - unstorable << " rejected, "
+                                 << unstorable << " out of band)\n"
+              << "elapsed:     " << secs * 1e3 << " ms\n"
+              << "throughput:  " << static_cast<long>(journal.size() / secs) << " cmds/s\n"
+              << "orders:      " << book.total_orders() << "\n"
+              << "levels:      " << book.total_bid_levels() << " bid, "
+                                 << book.total_ask_levels() << " ask\n"
+              << "top of book: " << top.bid_qty << " @ " << top.bid_price << " / "
+                                 << top.ask_qty << " @ " << top.ask_price << "\n";
+    if (unstorable > 0)
+        std::cerr << "warning: " << unstorable << " commands priced outside the ladder band ["
+                  << cfg.base_price << ", "
+                  << cfg.base_price + (cfg.num_levels - 1) * cfg.tick_size << "] step "
+                  << cfg.tick_size << "; the rebuilt book is not the recorded one\n";
+    return strict && rejected > 0 ? 2 : 0;
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    bool use_ladder = false;
+    LadderConfig ladder;
+    bool strict = false;
+    bool bad_args = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ladder" && i + 3 < argc) {
+            use_ladder = true;
+            ladder.base_price = std::stoull(argv[++i]);
+            ladder.tick_size = std::stoull(argv[++i]);
+            ladder.num_levels = std::stoul(argv[++i]);
+            bad_args |= ladder.tick_size == 0 || ladder.num_levels == 0;
+        } else if (arg == "--strict")
+            strict = true;
+        else if (path.empty() && arg.rfind("--", 0) != 0)
+            path = arg;
+        else
+            bad_args = true;
+    }
+    if (path.empty() || bad_args) {
+        std::cerr << "usage: " << argv[0] << " FILE [--ladder BASE TICK LEVELS] [--strict]\n";
+        return 1;
+    }
+
+    try {
+        JournalReader journal(path);
+        std::cout << "journal:     " << path << " ("
+                  << (use_ladder ? "TickLadder" : "MapLevels") << ")\n";
+        return use_ladder ? rebuild<TickLadder>(journal, ladder, strict)
+                          : rebuild<MapLevels>(journal, ladder, strict);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,276 @@
+#include "order_book.h"
+#include "journal.h"
+#include "thread_placement.h"
+#include "work_stealing.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Backtest a multi-symbol command stream on every core: one independent
+// single-threaded book per symbol, symbols spread over worker threads by
+// work stealing, at 1, 2, 4, ... threads.
+//
+//   replay_symbols FILE [--map] [--threads N] [--pin MODE] [--top K] [--csv PATH]
+//
+// FILE is a journal (e.g. bench_micro --dump FILE --symbols 500). Records
+// are grouped by symbol_id first (a counting sort, timed on its own), so
+// each symbol replays from one contiguous run of records. Symbols are
+// dealt to workers largest first. The per-symbol results must come out the
+// same at every thread count; the tool checks that and exits 2 otherwise.
+//
+// Books are NullLockPolicy, TickLadder unless --map. --threads caps the
+// scan (default: every CPU); --pin takes the placement names of
+// bench_sharding (default compact).
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct SymbolStats {
+    uint32_t symbol   = 0;
+    uint64_t commands = 0;
+    uint64_t accepted = 0;
+    uint64_t fills    = 0;
+    uint64_t volume   = 0;
+    uint64_t best_bid = 0;   // 0 = side empty
+    uint64_t best_ask = 0;
+    uint64_t resting  = 0;
+
+    bool operator==(const SymbolStats& o) const {
+        return symbol == o.symbol && commands == o.commands && accepted == o.accepted
+            && fills == o.fills && volume == o.volume && best_bid == o.best_bid
+            && best_ask == o.best_ask && resting == o.resting;
+    }
+    bool operator!=(const SymbolStats& o) const { return !(*this == o); }
+};
+
+// The journal regrouped by symbol: symbols[k]'s records are
+// records[first[k], first[k + 1]), in their original order.
+struct Partition {
+    std::vector<uint32_t> symbols;
+    std::vector<size_t> first;
+    std::vector<JournalRecord> records;
+
+    size_t count(size_t k) const { return first[k + 1] - first[k]; }
+};
+
+// Counts are kept per distinct symbol, not indexed by id, so memory follows
+// the number of symbols rather than the largest symbol_id in the file.
+Partition partition_by_symbol(const JournalReader& journal) {
+    std::unordered_map<uint32_t, size_t> pos;
+    for (const JournalRecord& r : journal)
+        ++pos[r.symbol_id];
+
+    Partition p;
+    p.symbols.reserve(pos.size());
+    for (const auto& [symbol, count] : pos)
+        p.symbols.push_back(symbol);
+    std::sort(p.symbols.begin(), p.symbols.end());
+
+    size_t start = 0;
+    for (uint32_t s : p.symbols) {
+        p.first.push_back(start);
+        size_t count = pos[s];
+        pos[s] = start;   // now: where symbol s's next record goes
+        start += count;
+    }
+    p.first.push_back(journal.size());
+
+    p.records.resize(journal.size());
+    for (const JournalRecord& r : journal)
+        p.records[pos[r.symbol_id]++] = r;
+    return p;
+}
+
+template <typename Levels>
+SymbolStats replay_symbol(const Partition& p, size_t k, ExecutionRing& fills) {
+    OrderBook<NullLockPolicy, Levels> book;
+    SymbolStats st;
+    st.symbol = p.symbols[k];
+    st.commands = p.count(k);
+
+    const JournalRecord* r = p.records.data() + p.first[k];
+    const JournalRecord* last = p.records.data() + p.first[k + 1];
+    Execution e;
+    for (; r != last; ++r) {
+        if (r->kind == JournalRecord::ADD)
+            st.accepted += book.add_order(to_order(*r), &fills);
+        else if (r->kind == JournalRecord::MODIFY)
+            st.accepted += book.modify_order(r->order_id, r->price, r->quantity, &fills);
+        else
+            st.accepted += book.cancel_order(r->order_id);
+        while (fills.pop(e)) {
+            ++st.fills;
+            st.volume += e.quantity;
+        }
+    }
+    st.fills += fills.dropped();
+    fills.clear();
+
+    st.best_bid = book.best_bid_price().value_or(0);
+    st.best_ask = book.best_ask_price().value_or(0);
+    st.resting = book.total_orders();
+    return st;
+}
+
+struct RunResult {
+    double secs;
+    size_t steals;
+};
+
+template <typename Levels>
+RunResult run(const Partition& p, const std::vector<size_t>& order, const std::vector<int>& cpus,
+              std::vector<SymbolStats>& stats) {
+    size_t workers = cpus.size();
+    std::vector<std::unique_ptr<ExecutionRing>> rings;
+    for (size_t w = 0; w < workers; ++w)
+        rings.push_back(std::make_unique<ExecutionRing>(1 << 16));
+    stats.assign(p.symbols.size(), SymbolStats{});
+
+    auto t0 = Clock::now();
+    std::vector<StealStats> ws = run_work_stealing(order.size(), cpus, [&](size_t task, size_t w) {
+        size_t k = order[task];
+        stats[k] = replay_symbol<Levels>(p, k, *rings[w]);
+    });
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    RunResult r{secs, 0};
+    for (const StealStats& s : ws)
+        r.steals += s.steals;
+    return r;
+}
+
+template <typename Levels>
+int backtest(const JournalReader& journal, size_t max_threads, Placement placement,
+             size_t top, const std::string& csv_path) {
+    auto t0 = Clock::now();
+    Partition p = partition_by_symbol(journal);
+    double part_secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::vector<size_t> counts(p.symbols.size());
+    for (size_t k = 0; k < counts.size(); ++k)
+        counts[k] = p.count(k);
+    size_t largest = counts.empty() ? 0 : *std::max_element(counts.begin(), counts.end());
+
+    std::cout << "commands:    " << journal.size() << " over " << p.symbols.size() << " symbols\n"
+              << "partition:   " << part_secs * 1e3 << " ms\n"
+              << "largest:     " << largest << " commands ("
+              << std::fixed << std::setprecision(1)
+              << 100.0 * static_cast<double>(largest) / static_cast<double>(std::max<size_t>(1, journal.size()))
+              << "% - bounds the speedup)\n\n" << std::defaultfloat << std::setprecision(4);
+
+    CpuTopology topo = CpuTopology::detect();
+    std::vector<SymbolStats> baseline, stats;
+    double base_secs = 0;
+    bool consistent = true;
+
+    // Untimed pass first, so the 1-thread row isn't charged for faulting in
+    // the records and the allocator's first pages
+    run<Levels>(p, deal_by_cost(counts, 1), plan_threads(topo, placement, 1), baseline);
+
+    std::cout << "threads  elapsed_ms   cmds/s       speedup  steals\n";
+    for (size_t t = 1; t <= max_threads; t = (t < max_threads && t * 2 > max_threads) ? max_threads : t * 2) {
+        std::vector<int> cpus = plan_threads(topo, placement, t);
+        RunResult r = run<Levels>(p, deal_by_cost(counts, t), cpus, t == 1 ? baseline : stats);
+        if (t == 1)
+            base_secs = r.secs;
+        else if (stats != baseline)
+            consistent = false;
+
+        std::cout << std::left << std::setw(9) << t
+                  << std::setw(13) << r.secs * 1e3
+                  << std::setw(13) << static_cast<long>(static_cast<double>(journal.size()) / r.secs)
+                  << std::setw(9) << base_secs / r.secs
+                  << r.steals << "\n" << std::right;
+    }
+
+    uint64_t accepted = 0, fills = 0, volume = 0, resting = 0;
+    for (const SymbolStats& s : baseline) {
+        accepted += s.accepted;
+        fills += s.fills;
+        volume += s.volume;
+        resting += s.resting;
+    }
+    std::cout << "\naccepted:    " << accepted << "\n"
+              << "fills:       " << fills << " (" << volume << " traded)\n"
+              << "resting:     " << resting << " orders\n";
+
+    std::vector<SymbolStats> busiest = baseline;
+    std::sort(busiest.begin(), busiest.end(),
+              [](const SymbolStats& a, const SymbolStats& b) { return a.commands > b.commands; });
+    busiest.resize(std::min(top, busiest.size()));
+    if (!busiest.empty())
+        std::cout << "\nsymbol   commands   fills      volume      bid      ask      resting\n";
+    for (const SymbolStats& s : busiest)
+        std::cout << std::left << std::setw(9) << s.symbol << std::setw(11) << s.commands
+                  << std::setw(11) << s.fills << std::setw(12) << s.volume
+                  << std::setw(9) << s.best_bid << std::setw(9) << s.best_ask
+                  << s.resting << "\n" << std::right;
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path);
+        csv << "symbol,commands,accepted,fills,volume,best_bid,best_ask,resting\n";
+        for (const SymbolStats& s : baseline)
+            csv << s.symbol << "," << s.commands << "," << s.accepted << "," << s.fills << ","
+                << s.volume << "," << s.best_bid << "," << s.best_ask << "," << s.resting << "\n";
+        std::cout << "\nPer-symbol results → " << csv_path << "\n";
+    }
+
+    if (!consistent) {
+        std::cerr << "per-symbol results differ between thread counts\n";
+        return 2;
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string path, csv_path;
+    bool use_map = false;
+    size_t max_threads = CpuTopology::detect().cpus().size();
+    size_t top = 10;
+    Placement placement = Placement::COMPACT;
+    bool bad_args = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_val = i + 1 < argc;
+        if (arg == "--map")
+            use_map = true;
+        else if (arg == "--threads" && has_val)
+            max_threads = std::stoul(argv[++i]);
+        else if (arg == "--top" && has_val)
+            top = std::stoul(argv[++i]);
+        else if (arg == "--csv" && has_val)
+            csv_path = argv[++i];
+        else if (arg == "--pin" && has_val)
+            bad_args |= !parse_placement(argv[++i], placement);
+        else if (path.empty() && arg.rfind("--", 0) != 0)
+            path = arg;
+        else
+            bad_args = true;
+    }
+    if (path.empty() || bad_args || max_threads == 0) {
+        std::cerr << "usage: " << argv[0]
+                  << " FILE [--map] [--threads N] [--pin MODE] [--top K] [--csv PATH]\n";
+        return 1;
+    }
+
+    try {
+        JournalReader journal(path);
+        std::cout << "journal:     " << path << " ("
+                  << (use_map ? "MapLevels" : "TickLadder") << ", "
+                  << placement_name(placement) << " placement)\n";
+        return use_map ? backtest<MapLevels>(journal, max_threads, placement, top, csv_path)
+                       : backtest<TickLadder>(journal, max_threads, placement, top, csv_path);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}